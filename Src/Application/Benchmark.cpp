@@ -0,0 +1,298 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+
+#include "Benchmark.h"
+#include "Macros.h"
+
+#include "Classic/Application.h"
+#include "Evolved/Application.h"
+#include "EvolvedPlus/Application.h"
+
+/**
+Default amount of ticks performed on every benchmarked level.
+*/
+#define DEFAULT_TICK_COUNT 10
+
+/**
+Default percentage a metric can get worse, compared to its baseline, before it's
+considered a regression.
+*/
+#define DEFAULT_REGRESSION_THRESHOLD 10.0
+
+/**
+Alias for the metrics of a benchmark run, by name. Names are made of the architecture,
+the amount of entities and the metric, i.e. EvolvedPlus.10000.tick_p95.
+*/
+typedef std::map<std::string, double> TMetrics;
+
+/**
+Writes the header of the results table.
+*/
+static void printHeader(std::ostream &os) {
+	os << std::left << std::setw(14) << "architecture" << std::right
+	   << std::setw(10) << "entities"
+	   << std::setw(12) << "build"
+	   << std::setw(12) << "initialize"
+	   << std::setw(12) << "activate"
+	   << std::setw(12) << "tick p50"
+	   << std::setw(12) << "tick max"
+	   << std::setw(14) << "sendMessage"
+	   << std::setw(12) << "memory"
+	   << "   (ms, KB of working set growth)" << std::endl;
+}
+
+/**
+Writes a row of the results table, with every time in milliseconds.
+*/
+static void printResult(std::ostream &os, const Application::CBenchmarkResult &result) {
+	os << std::left << std::setw(14) << result.architecture << std::right
+	   << std::setw(10) << result.entityCount
+	   << std::fixed << std::setprecision(3)
+	   << std::setw(12) << result.buildTime * 1000.0
+	   << std::setw(12) << result.initializeTime * 1000.0
+	   << std::setw(12) << result.activateTime * 1000.0
+	   << std::setw(12) << result.ticks.getPercentile(50.0f) * 1000.0
+	   << std::setw(12) << result.ticks.getMax() * 1000.0
+	   << std::setw(14) << result.sendMessageTime * 1000.0
+	   << std::setw(12) << result.workingSetGrowth / 1024
+	   << std::endl;
+}
+/**
+Extracts the metrics we keep track of from a benchmark result.
+Times are in seconds and memory in bytes.
+*/
+static void addMetrics(const Application::CBenchmarkResult &result, TMetrics &metrics) {
+	std::ostringstream prefix;
+	prefix << result.architecture << "." << result.entityCount << ".";
+
+	metrics[prefix.str() + "load"] = result.buildTime + result.initializeTime + result.activateTime;
+	metrics[prefix.str() + "tick_p50"] = result.ticks.getPercentile(50.0f);
+	metrics[prefix.str() + "tick_p95"] = result.ticks.getPercentile(95.0f);
+	metrics[prefix.str() + "tick_p99"] = result.ticks.getPercentile(99.0f);
+	metrics[prefix.str() + "messages_per_second"] = result.sendMessageTime > 0.0 ?
+	                                                result.messageCount / result.sendMessageTime : 0.0;
+	metrics[prefix.str() + "working_set_growth"] = static_cast<double>(result.workingSetGrowth);
+}
+
+/**
+Whether a metric gets better the higher it is. Otherwise, it gets better the lower it is.
+*/
+static bool isHigherBetter(const std::string &metric) {
+	const std::string suffix = "per_second";
+
+	return metric.size() >= suffix.size() && metric.compare(metric.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+Writes metrics into a baseline file, one "<name> <value>" per line.
+*/
+static bool writeBaseline(const std::string &fileName, const TMetrics &metrics) {
+	std::ofstream out(fileName.c_str());
+
+	if(!out) {
+		return false;
+	}
+
+	out << std::setprecision(9);
+	bool first = true;
+
+	FOR_IT_CONST(TMetrics, it, metrics) {
+		// the last line can't be followed by an empty line
+		if(!first) {
+			out << std::endl;
+		}
+
+		out << it->first << " " << it->second;
+		first = false;
+	}
+
+	return true;
+}
+
+/**
+Reads metrics from a baseline file.
+*/
+static bool readBaseline(const std::string &fileName, TMetrics &outMetrics) {
+	std::ifstream in(fileName.c_str());
+
+	if(!in) {
+		return false;
+	}
+
+	std::string name;
+	double value;
+
+	while(in >> name >> value) {
+		outMetrics[name] = value;
+	}
+
+	return true;
+}
+
+/**
+Compares metrics against a baseline, and writes how every one of them changed.
+Returns how many metrics got worse by more than the threshold (a percentage).
+*/
+static unsigned int compareBaseline(std::ostream &os, const TMetrics &baseline, const TMetrics &metrics,
+                                    double threshold) {
+	unsigned int regressions = 0;
+
+	// keep the stream as it was given to us
+	std::ios::fmtflags flags = os.flags();
+	std::streamsize precision = os.precision();
+
+	os << std::left << std::setw(44) << "metric" << std::right
+	   << std::setw(16) << "baseline"
+	   << std::setw(16) << "current"
+	   << std::setw(10) << "change" << std::endl;
+
+	FOR_IT_CONST(TMetrics, it, metrics) {
+		TMetrics::const_iterator itBaseline = baseline.find(it->first);
+
+		os << std::left << std::setw(44) << it->first << std::right;
+		os.unsetf(std::ios::fixed);
+		os << std::setprecision(6);
+
+		if(itBaseline == baseline.end()) {
+			os << std::setw(16) << "-" << std::setw(16) << it->second << "   not in baseline" << std::endl;
+			continue;
+		}
+
+		// change in percentage, positive when the metric got bigger
+		double change = itBaseline->second != 0.0 ? (it->second - itBaseline->second) / itBaseline->second * 100.0 : 0.0;
+		double worsening = isHigherBetter(it->first) ? -change : change;
+
+		os << std::setw(16) << itBaseline->second
+		   << std::setw(16) << it->second
+		   << std::fixed << std::setprecision(1) << std::showpos
+		   << std::setw(9) << change << "%" << std::noshowpos;
+
+		if(worsening > threshold) {
+			os << "   REGRESSION";
+			regressions++;
+		}
+
+		os << std::endl;
+	}
+
+	os.flags(flags);
+	os.precision(precision);
+
+	return regressions;
+}
+
+/**
+Entry point of the benchmark, which measures every architecture side by side so we can
+compare how they scale.
+For every requested size, a synthetic level is generated in the format each architecture
+understands (it must be executed from the same directory as the sample application, since
+blueprints, archetypes and config files are needed). Then, every part of the level's life
+cycle is measured.
+
+Usage: Benchmark [-ticks <count>] [-baseline <file>] [-compare <file>] [-threshold <percentage>] [<entity count> ...]
+By default it ticks every level 10 times and benchmarks levels of 1k, 10k, 100k and 1M entities.
+Load time, frame time percentiles, messages per second and working set growth can be written into
+a baseline file (-baseline), or compared against one (-compare). When comparing, every metric
+which got worse by more than the threshold (10% by default) is reported as a regression, and
+the benchmark exits with an error so scripts can tell.
+*/
+int main(int argc, char **argv) {
+	unsigned int tickCount = DEFAULT_TICK_COUNT;
+	double threshold = DEFAULT_REGRESSION_THRESHOLD;
+	std::string baselineFile;
+	std::string compareFile;
+	std::vector<unsigned int> entityCounts;
+
+	// parse the command line
+	for(int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+
+		if(argument == "-ticks" && i + 1 < argc) {
+			tickCount = std::atoi(argv[++i]);
+		} else if(argument == "-baseline" && i + 1 < argc) {
+			baselineFile = argv[++i];
+		} else if(argument == "-compare" && i + 1 < argc) {
+			compareFile = argv[++i];
+		} else if(argument == "-threshold" && i + 1 < argc) {
+			threshold = std::atof(argv[++i]);
+		} else {
+			entityCounts.push_back(std::atoi(argv[i]));
+		}
+	}
+
+	if(entityCounts.empty()) {
+		entityCounts.push_back(1000);
+		entityCounts.push_back(10000);
+		entityCounts.push_back(100000);
+		entityCounts.push_back(1000000);
+	}
+
+	// bring up every subsystem of every architecture, they must remain alive until we finish
+	// since components and messages are only registered into their factories once
+	Classic::CApplication::getInstance();
+	Evolved::CApplication::getInstance();
+	EvolvedPlus::CApplication::getInstance();
+
+	printHeader(std::cout);
+	TMetrics metrics;
+
+	FOR_IT_CONST(std::vector<unsigned int>, it, entityCounts) {
+		// every architecture is benchmarked with the same size before going on with the next one
+		Application::CBenchmarkResult result;
+		Application::benchmarkClassic(*it, tickCount, result);
+		printResult(std::cout, result);
+		addMetrics(result, metrics);
+
+		result = Application::CBenchmarkResult();
+		Application::benchmarkEvolved(*it, tickCount, result);
+		printResult(std::cout, result);
+		addMetrics(result, metrics);
+
+		result = Application::CBenchmarkResult();
+		Application::benchmarkEvolvedPlus(*it, tickCount, result);
+		printResult(std::cout, result);
+		addMetrics(result, metrics);
+
+		std::cout << std::endl;
+	}
+
+	// finally, destroy every application
+	Classic::CApplication::release();
+	Evolved::CApplication::release();
+	EvolvedPlus::CApplication::release();
+
+	// keep the results as a baseline for later runs
+	if(!baselineFile.empty()) {
+		if(writeBaseline(baselineFile, metrics)) {
+			std::cout << "Baseline written to " << baselineFile << std::endl;
+		} else {
+			std::cerr << "Couldn't write baseline " << baselineFile << std::endl;
+			return 1;
+		}
+	}
+
+	// or compare them against a previous baseline
+	if(!compareFile.empty()) {
+		TMetrics baseline;
+
+		if(!readBaseline(compareFile, baseline)) {
+			std::cerr << "Couldn't read baseline " << compareFile << std::endl;
+			return 1;
+		}
+
+		unsigned int regressions = compareBaseline(std::cout, baseline, metrics, threshold);
+		std::cout << std::endl << regressions << " regressions beyond " << threshold << "%" << std::endl;
+
+		if(regressions > 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
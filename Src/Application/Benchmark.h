@@ -0,0 +1,96 @@
+#ifndef Application_Benchmark_H
+#define Application_Benchmark_H
+
+#include <string>
+#include <cstddef>
+
+#include "FrameStatistics.h"
+
+namespace Application {
+
+	/**
+	Every architecture is ticked with the same controlled delta time, so components with
+	an update frequency are ticked the same amount of times in all of them.
+	*/
+#define BENCHMARK_DELTA_TIME 0.03f
+
+	/**
+	Stores the measurements taken while benchmarking an architecture with a level
+	of a given size.
+	Every time is expressed in seconds.
+	*/
+	struct CBenchmarkResult {
+		/**
+		Name of the benchmarked architecture.
+		*/
+		std::string architecture;
+
+		/**
+		How many entities the generated level had.
+		*/
+		unsigned int entityCount;
+
+		/**
+		Time it took to build the level from its file (first step of the initialization).
+		*/
+		double buildTime;
+
+		/**
+		Time it took to initialize the level (second step of the initialization).
+		*/
+		double initializeTime;
+
+		/**
+		Time it took to activate the level.
+		*/
+		double activateTime;
+
+		/**
+		Duration of every tick performed on the level.
+		*/
+		CFrameStatistics ticks;
+
+		/**
+		Time it took to send one message to every entity in the level.
+		*/
+		double sendMessageTime;
+
+		/**
+		How many messages were sent while measuring sendMessageTime.
+		*/
+		unsigned int messageCount;
+
+		/**
+		How much the working set of the process grew from right before building the level until
+		it was built, ticked and had a message in flight for every entity, in bytes.
+		It's a difference between two samples, not a peak, and memory released by previous
+		benchmarks in the same process (and reused by the allocator) isn't counted.
+		*/
+		std::size_t workingSetGrowth;
+
+		/**
+		Default constructor.
+		*/
+		CBenchmarkResult() : entityCount(0), buildTime(0.0), initializeTime(0.0), activateTime(0.0),
+			sendMessageTime(0.0), messageCount(0), workingSetGrowth(0) {
+
+		}
+	};
+
+	/**
+	Every architecture provides the same entry point to be benchmarked. It generates a
+	level with the given amount of entities in the format the architecture understands,
+	and then measures its life cycle: build, initialize, activate, tick and sendMessage.
+	The generated level is removed once the benchmark finishes.
+	Subsystems of the architecture must be up before calling them, and they can't be
+	brought up again once released.
+
+	@see Component.h, Message.h to get more info on this restriction.
+	*/
+	void benchmarkClassic(unsigned int entityCount, unsigned int tickCount, CBenchmarkResult &result);
+	void benchmarkEvolved(unsigned int entityCount, unsigned int tickCount, CBenchmarkResult &result);
+	void benchmarkEvolvedPlus(unsigned int entityCount, unsigned int tickCount, CBenchmarkResult &result);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Timer.h"
+#include "Memory.h"
+#include "Macros.h"
+
+#include "Classic/Entity/Entity.h"
+#include "Classic/Entity/EntityFactory.h"
+#include "Classic/Level/Level.h"
+#include "Classic/Level/LevelFactory.h"
+#include "Classic/Samples/Messages/SetPosition.h"
+
+namespace Application {
+
+#define CLASSIC_BENCHMARK_LEVEL "Benchmark_Classic.txt"
+
+	/**
+	Writes a level file with the given amount of entities.
+	Blueprints are always read from the same file, so entities use a type which is
+	already defined in it.
+	*/
+	static void generateClassicLevel(const std::string &fileName, unsigned int entityCount) {
+		std::ofstream out(fileName.c_str());
+
+		for(unsigned int i = 0; i < entityCount; ++i) {
+			// entries are separated by an empty line, and the last one can't be followed by one
+			if(i > 0) {
+				out << std::endl << std::endl;
+			}
+
+			out << "Entity " << i << " : EntityTest" << std::endl;
+			out << "\tposition " << i << " 0 0" << std::endl;
+			out << "\tmodel Model.fbx";
+		}
+	}
+
+	void benchmarkClassic(unsigned int entityCount, unsigned int tickCount, CBenchmarkResult &result) {
+		result.architecture = "Classic";
+		result.entityCount = entityCount;
+
+		generateClassicLevel(CLASSIC_BENCHMARK_LEVEL, entityCount);
+
+		// whatever the level needs from now on is on its own
+		std::size_t memory = getResidentMemory();
+
+		CTimer timer;
+
+		// build the level
+		Classic::CLevel *level = Classic::CLevelFactory::getInstance().build(CLASSIC_BENCHMARK_LEVEL);
+		result.buildTime = timer.getElapsedSeconds();
+
+		// initialize it
+		timer.start();
+		level->initialize();
+		result.initializeTime = timer.getElapsedSeconds();
+
+		// activate it
+		timer.start();
+		level->activate();
+		result.activateTime = timer.getElapsedSeconds();
+
+		// tick it, just like the game loop would do
+		result.ticks.reserve(tickCount);
+
+		for(unsigned int i = 0; i < tickCount; ++i) {
+			timer.start();
+			level->tick(BENCHMARK_DELTA_TIME);
+			Classic::CEntityFactory::getInstance().deletePendingEntities();
+			result.ticks.addFrame(timer.getElapsedSeconds());
+		}
+
+		// send a message to every entity in the level
+		std::vector<Classic::CEntity *> entities;
+		level->getEntities(entities);
+
+		timer.start();
+
+		FOR_IT_CONST(std::vector<Classic::CEntity *>, it, entities) {
+			(*it)->sendMessage(new Classic::Samples::Messages::CSetPosition(Vector3(1.0f, 0.0f, 0.0f)));
+		}
+
+		result.sendMessageTime = timer.getElapsedSeconds();
+		result.messageCount = entities.size();
+
+		// the level is as big as it gets now, so see how much the working set grew
+		std::size_t grownMemory = getResidentMemory();
+		result.workingSetGrowth = grownMemory > memory ? grownMemory - memory : 0;
+
+		// let components process those messages before getting rid of the level
+		level->tick(BENCHMARK_DELTA_TIME);
+		level->deactivate();
+		delete level;
+
+		std::remove(CLASSIC_BENCHMARK_LEVEL);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Timer.h"
+#include "Memory.h"
+#include "Macros.h"
+
+#include "Evolved/Level/Level.h"
+#include "Evolved/Level/LevelFactory.h"
+#include "Evolved/Messages/Pool.h"
+#include "Evolved/Samples/Messages/SetPosition.h"
+
+namespace Application {
+
+#define EVOLVED_BENCHMARK_LEVEL "Benchmark_Evolved.txt"
+
+	/**
+	Writes a level file with the given amount of entities.
+	Components are inferred from the level, so we alternate between two types of
+	entities with a different set of components each.
+	*/
+	static void generateEvolvedLevel(const std::string &fileName, unsigned int entityCount) {
+		std::ofstream out(fileName.c_str());
+
+		for(unsigned int i = 0; i < entityCount; ++i) {
+			// entries are separated by an empty line, and the last one can't be followed by one
+			if(i > 0) {
+				out << std::endl << std::endl;
+			}
+
+			if(i % 2 == 0) {
+				out << "Entity " << i << " : Type A" << std::endl;
+				out << "\tCLight" << std::endl;
+				out << "\t\ttype Directional" << std::endl;
+				out << "\t\tcolor 1 1 1" << std::endl;
+				out << "\tCPerception" << std::endl;
+				out << "\t\ttype Enemy" << std::endl;
+				out << "\tCGraphics" << std::endl;
+				out << "\t\tmodel Model.fbx" << std::endl;
+				out << "\t\tposition " << i << " 0 0";
+			} else {
+				out << "Entity " << i << " : Type B" << std::endl;
+				out << "\tCGraphics" << std::endl;
+				out << "\t\tmodel Model.fbx" << std::endl;
+				out << "\tCPerception" << std::endl;
+				out << "\t\ttype Type Alpha";
+			}
+		}
+	}
+
+	void benchmarkEvolved(unsigned int entityCount, unsigned int tickCount, CBenchmarkResult &result) {
+		result.architecture = "Evolved";
+		result.entityCount = entityCount;
+
+		generateEvolvedLevel(EVOLVED_BENCHMARK_LEVEL, entityCount);
+
+		// whatever the level needs from now on is on its own
+		std::size_t memory = getResidentMemory();
+
+		CTimer timer;
+
+		// build the level
+		Evolved::CLevel *level = Evolved::CLevelFactory::getInstance().build(EVOLVED_BENCHMARK_LEVEL);
+		result.buildTime = timer.getElapsedSeconds();
+
+		// initialize it
+		timer.start();
+		level->initialize();
+		result.initializeTime = timer.getElapsedSeconds();
+
+		// activate it
+		timer.start();
+		level->activate();
+		result.activateTime = timer.getElapsedSeconds();
+
+		// tick it, just like the game loop would do
+		result.ticks.reserve(tickCount);
+
+		for(unsigned int i = 0; i < tickCount; ++i) {
+			timer.start();
+			level->tick(BENCHMARK_DELTA_TIME);
+			result.ticks.addFrame(timer.getElapsedSeconds());
+		}
+
+		// send a message to every entity in the level
+		std::vector<Evolved::TEntityID> entities;
+		level->getEntities(entities);
+
+		Evolved::Messages::CPool &pool = Evolved::Messages::CPool::getInstance();
+
+		timer.start();
+
+		FOR_IT_CONST(std::vector<Evolved::TEntityID>, it, entities) {
+			Evolved::Samples::Messages::CSetPosition *message = pool.obtainMessage<Evolved::Samples::Messages::CSetPosition>();
+			message->init(Vector3(1.0f, 0.0f, 0.0f));
+			level->sendMessage(*it, message);
+		}
+
+		result.sendMessageTime = timer.getElapsedSeconds();
+		result.messageCount = entities.size();
+
+		// the level is as big as it gets now, so see how much the working set grew
+		std::size_t grownMemory = getResidentMemory();
+		result.workingSetGrowth = grownMemory > memory ? grownMemory - memory : 0;
+
+		// let components process those messages before getting rid of the level
+		level->tick(BENCHMARK_DELTA_TIME);
+		level->deactivate();
+		delete level;
+
+		std::remove(EVOLVED_BENCHMARK_LEVEL);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Timer.h"
+#include "Memory.h"
+#include "Macros.h"
+
+#include "EvolvedPlus/Level/Level.h"
+#include "EvolvedPlus/Level/LevelFactory.h"
+#include "EvolvedPlus/Messages/Pool.h"
+#include "EvolvedPlus/Profiling/StartupProfiler.h"
+#include "EvolvedPlus/Samples/Messages/SetPosition.h"
+
+namespace Application {
+
+#define EVOLVED_PLUS_BENCHMARK_LEVEL "Benchmark_EvolvedPlus.txt"
+
+	/**
+	Writes a level file with the given amount of entities.
+	Entities are spread between those which use archetypes (with and without overriding
+	their data) and those which define every component in the level, so property lookups
+	through archetype hierarchies are part of the measurements.
+	*/
+	static void generateEvolvedPlusLevel(const std::string &fileName, unsigned int entityCount) {
+		std::ofstream out(fileName.c_str());
+
+		for(unsigned int i = 0; i < entityCount; ++i) {
+			// entries are separated by an empty line, and the last one can't be followed by one
+			if(i > 0) {
+				out << std::endl << std::endl;
+			}
+
+			switch(i % 3) {
+				case 0:
+					out << "Entity " << i << " : [GraphicalLight]";
+					break;
+
+				case 1:
+					out << "Entity " << i << " : [Archetype 1]" << std::endl;
+					out << "\tCLight" << std::endl;
+					out << "\t\tcolor 1 0 0" << std::endl;
+					out << "\tCGraphics" << std::endl;
+					out << "\t\tposition " << i << " 0 0";
+					break;
+
+				default:
+					out << "Entity " << i << " : Type B" << std::endl;
+					out << "\tCGraphics" << std::endl;
+					out << "\t\tmodel Model.fbx" << std::endl;
+					out << "\tCPerception" << std::endl;
+					out << "\t\ttype Type Alpha";
+					break;
+			}
+		}
+	}
+
+	void benchmarkEvolvedPlus(unsigned int entityCount, unsigned int tickCount, CBenchmarkResult &result) {
+		result.architecture = "EvolvedPlus";
+		result.entityCount = entityCount;
+
+		// the architecture is already up, so loading levels isn't part of its start up anymore
+		EvolvedPlus::Profiling::CStartupProfiler::getInstance().finish();
+
+		generateEvolvedPlusLevel(EVOLVED_PLUS_BENCHMARK_LEVEL, entityCount);
+
+		// whatever the level needs from now on is on its own
+		std::size_t memory = getResidentMemory();
+
+		CTimer timer;
+
+		// build the level
+		EvolvedPlus::CLevel *level = EvolvedPlus::CLevelFactory::getInstance().build(EVOLVED_PLUS_BENCHMARK_LEVEL);
+		result.buildTime = timer.getElapsedSeconds();
+
+		// initialize it
+		timer.start();
+		level->initialize();
+		result.initializeTime = timer.getElapsedSeconds();
+
+		// activate it
+		timer.start();
+		level->activate();
+		result.activateTime = timer.getElapsedSeconds();
+
+		// tick it, just like the game loop would do
+		result.ticks.reserve(tickCount);
+
+		for(unsigned int i = 0; i < tickCount; ++i) {
+			timer.start();
+			level->tick(BENCHMARK_DELTA_TIME);
+			result.ticks.addFrame(timer.getElapsedSeconds());
+		}
+
+		// send a message to every entity in the level
+		std::vector<EvolvedPlus::TEntityID> entities;
+		level->getEntities(entities);
+
+		EvolvedPlus::Messages::CPool &pool = EvolvedPlus::Messages::CPool::getInstance();
+
+		timer.start();
+
+		FOR_IT_CONST(std::vector<EvolvedPlus::TEntityID>, it, entities) {
+			EvolvedPlus::Samples::Messages::CSetPosition *message = pool.obtainMessage<EvolvedPlus::Samples::Messages::CSetPosition>();
+			message->init(Vector3(1.0f, 0.0f, 0.0f));
+			level->sendMessage(*it, message);
+		}
+
+		result.sendMessageTime = timer.getElapsedSeconds();
+		result.messageCount = entities.size();
+
+		// the level is as big as it gets now, so see how much the working set grew
+		std::size_t grownMemory = getResidentMemory();
+		result.workingSetGrowth = grownMemory > memory ? grownMemory - memory : 0;
+
+		// let components process those messages before getting rid of the level
+		level->tick(BENCHMARK_DELTA_TIME);
+		level->deactivate();
+		delete level;
+
+		std::remove(EVOLVED_PLUS_BENCHMARK_LEVEL);
+	}
+
+}
\ No newline at end of file
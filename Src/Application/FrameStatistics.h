@@ -0,0 +1,140 @@
+#ifndef Application_FrameStatistics_H
+#define Application_FrameStatistics_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <ostream>
+#include <iomanip>
+
+namespace Application {
+
+	/**
+	Stores how long every frame took during an execution, so we can report how the
+	architecture behaved once it finishes.
+	Averages hide slow frames, so this class reports percentiles instead: a single frame
+	which takes way longer than the rest will show up in the max (and eventually in the
+	p99) even after thousands of ticks.
+	*/
+	class CFrameStatistics {
+	private:
+		/**
+		Alias for our list of frame times.
+		*/
+		typedef std::vector<double> TFrameTimes;
+
+		/**
+		Duration of every recorded frame, in seconds, in the order they were recorded.
+		*/
+		TFrameTimes _frameTimes;
+
+		/**
+		Sum of every recorded frame, in seconds.
+		*/
+		double _totalSeconds;
+
+	public:
+		/**
+		Default constructor.
+		*/
+		CFrameStatistics() : _totalSeconds(0.0) {
+
+		}
+
+		/**
+		Default destructor.
+		*/
+		~CFrameStatistics() {
+			_frameTimes.clear();
+		}
+
+		/**
+		Reserves room for a number of frames, so recording them doesn't allocate memory
+		while the level is being ticked.
+		*/
+		void reserve(unsigned int frameCount) {
+			_frameTimes.reserve(frameCount);
+		}
+
+		/**
+		Records how long a frame took, in seconds.
+		*/
+		void addFrame(double secs) {
+			_frameTimes.push_back(secs);
+			_totalSeconds += secs;
+		}
+
+		/**
+		Gets how many frames have been recorded.
+		*/
+		unsigned int getFrameCount() const {
+			return _frameTimes.size();
+		}
+
+		/**
+		Gets the sum of every recorded frame, in seconds.
+		*/
+		double getTotalSeconds() const {
+			return _totalSeconds;
+		}
+
+		/**
+		Gets the frame time, in seconds, below which the given percentage of frames are.
+		Uses the nearest-rank method, so the result is always one of the recorded frames.
+		*/
+		double getPercentile(float percentage) const {
+			if(_frameTimes.empty()) {
+				return 0.0;
+			}
+
+			// nearest rank, clamped to our range of frames
+			unsigned int rank = static_cast<unsigned int>(std::ceil(percentage / 100.0 * _frameTimes.size()));
+			rank = rank == 0 ? 0 : rank - 1;
+			rank = std::min<unsigned int>(rank, _frameTimes.size() - 1);
+
+			// partially sort a copy, we don't want to lose the order frames were recorded in
+			TFrameTimes sorted(_frameTimes);
+			std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+			return sorted[rank];
+		}
+
+		/**
+		Gets the slowest recorded frame, in seconds.
+		*/
+		double getMax() const {
+			return _frameTimes.empty() ? 0.0 : *std::max_element(_frameTimes.begin(), _frameTimes.end());
+		}
+
+		/**
+		Writes a human-readable summary of the recorded frames.
+		Entities per second is the amount of entity ticks performed per second, so it
+		takes into account how many entities were ticked every frame.
+		*/
+		void report(std::ostream &os, const std::string &name, unsigned int entityCount) const {
+			double ticksPerSecond = _totalSeconds > 0.0 ? getFrameCount() / _totalSeconds : 0.0;
+
+			// keep the stream as it was given to us
+			std::ios::fmtflags flags = os.flags();
+			std::streamsize precision = os.precision();
+			os << std::fixed << std::setprecision(4);
+
+			os << "[" << name << "] " << getFrameCount() << " frames in " << _totalSeconds << " s" << std::endl;
+			os << "\tframe time (ms): p50 " << getPercentile(50.0f) * 1000.0
+			   << " p95 " << getPercentile(95.0f) * 1000.0
+			   << " p99 " << getPercentile(99.0f) * 1000.0
+			   << " max " << getMax() * 1000.0 << std::endl;
+			os << "\tticks per second: " << ticksPerSecond << std::endl;
+			os << "\tentities per second: " << ticksPerSecond * entityCount << std::endl;
+
+			os.flags(flags);
+			os.precision(precision);
+		}
+	};
+
+}
+
+typedef Application::CFrameStatistics CFrameStatistics;
+
+#endif
\ No newline at end of file
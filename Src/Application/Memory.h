@@ -0,0 +1,57 @@
+#ifndef Application_Memory_H
+#define Application_Memory_H
+
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+namespace Application {
+
+	/**
+	Gets how much physical memory the process is using right now (its working set), in bytes.
+	Comparing two of its values tells how much the working set grew in between, which is
+	only a lower bound of what something needed: memory released earlier and reused by the
+	allocator doesn't show up, and neither do peaks in between both samples.
+	*/
+	inline std::size_t getResidentMemory() {
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+
+		if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return 0;
+		}
+
+		return counters.WorkingSetSize;
+#else
+		// second field of statm is the amount of resident pages
+		std::FILE *file = std::fopen("/proc/self/statm", "r");
+
+		if(!file) {
+			return 0;
+		}
+
+		unsigned long size = 0;
+		unsigned long resident = 0;
+		int read = std::fscanf(file, "%lu %lu", &size, &resident);
+		std::fclose(file);
+
+		return read == 2 ? static_cast<std::size_t>(resident) * sysconf(_SC_PAGESIZE) : 0;
+#endif
+	}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,525 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+#include "Timer.h"
+#include "Macros.h"
+#include "Vector3.h"
+
+#include "EvolvedPlus/Application.h"
+#include "EvolvedPlus/Properties.h"
+#include "EvolvedPlus/Entity/EntityData.h"
+#include "EvolvedPlus/Entity/EntityProperties.h"
+#include "EvolvedPlus/Level/Level.h"
+#include "EvolvedPlus/Level/LevelEntry.h"
+#include "EvolvedPlus/Messages/Pool.h"
+#include "EvolvedPlus/Messages/MessageTopic.h"
+#include "EvolvedPlus/Samples/Components/Graphics.h"
+#include "EvolvedPlus/Samples/Components/Light.h"
+#include "EvolvedPlus/Samples/Components/Perception.h"
+#include "EvolvedPlus/Samples/Messages/SetPosition.h"
+
+using namespace EvolvedPlus;
+
+/**
+Default amount of times every primitive is executed for each size.
+*/
+#define DEFAULT_ITERATION_COUNT 100000
+
+/**
+How many messages are in flight at the same time while measuring sendMessage.
+*/
+#define MESSAGE_BATCH_SIZE 1024
+
+/**
+Results of the measured primitives are accumulated here, so the compiler can't get
+rid of the calls we're measuring.
+*/
+static volatile unsigned int sink = 0;
+
+/**
+Writes the header of the results table.
+*/
+static void printHeader(std::ostream &os) {
+	os << std::left << std::setw(40) << "primitive" << std::right
+	   << std::setw(10) << "size"
+	   << std::setw(12) << "iterations"
+	   << std::setw(12) << "ns/op" << std::endl;
+}
+
+/**
+Writes a row of the results table.
+*/
+static void printResult(std::ostream &os, const std::string &primitive, unsigned int size,
+                        unsigned int iterations, double secs) {
+	os << std::left << std::setw(40) << primitive << std::right
+	   << std::setw(10) << size
+	   << std::setw(12) << iterations
+	   << std::fixed << std::setprecision(1)
+	   << std::setw(12) << (iterations > 0 ? secs / iterations * 1e9 : 0.0) << std::endl;
+}
+
+/**
+Generates a list of pseudo-random indices in [0, range), always the same ones, so
+lookups don't hit the same element over and over again.
+*/
+static void generateIndices(unsigned int count, unsigned int range, std::vector<unsigned int> &outIndices) {
+	std::srand(0);
+	outIndices.resize(count);
+
+	for(unsigned int i = 0; i < count; ++i) {
+		// rand() might not reach big ranges on its own
+		outIndices[i] = ((static_cast<unsigned int>(std::rand()) << 15) ^ static_cast<unsigned int>(std::rand())) % range;
+	}
+}
+
+/**
+Adds a new entity with the given components to a level, and returns its identifier.
+The level takes ownership of the components.
+*/
+static TEntityID addTestEntity(CLevel &level, const std::vector<IComponent *> &components) {
+	TEntityID id = CEntityID::nextID();
+
+	CEntityData data;
+	data.components = components;
+
+	FOR_IT_CONST(std::vector<IComponent *>, it, data.components) {
+		(*it)->setEntity(id);
+	}
+
+	level.addEntity(id, data);
+
+	return id;
+}
+
+/**
+CProperties::get<T> parses the stored string through an istringstream every time.
+*/
+static void benchmarkProperties(unsigned int iterations) {
+	const unsigned int sizes[] = { 4, 64, 1024 };
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		CProperties properties;
+
+		for(unsigned int i = 0; i < sizes[s]; ++i) {
+			std::ostringstream name;
+			name << "property" << i;
+			properties.put(name.str(), "1.5 2.5 3.5");
+		}
+
+		// look up names beforehand, we only want to measure get
+		std::vector<unsigned int> indices;
+		generateIndices(iterations, sizes[s], indices);
+		std::vector<std::string> names(iterations);
+
+		for(unsigned int i = 0; i < iterations; ++i) {
+			std::ostringstream name;
+			name << "property" << indices[i];
+			names[i] = name.str();
+		}
+
+		CTimer timer;
+		float floatValue;
+
+		FOR_IT_CONST(std::vector<std::string>, it, names) {
+			sink += properties.get<float>(*it, floatValue);
+		}
+
+		printResult(std::cout, "CProperties::get<float>", sizes[s], iterations, timer.getElapsedSeconds());
+
+		timer.start();
+		Vector3 vectorValue;
+
+		FOR_IT_CONST(std::vector<std::string>, it, names) {
+			sink += properties.get<Vector3>(*it, vectorValue);
+		}
+
+		printResult(std::cout, "CProperties::get<Vector3>", sizes[s], iterations, timer.getElapsedSeconds());
+
+		timer.start();
+		std::string stringValue;
+
+		FOR_IT_CONST(std::vector<std::string>, it, names) {
+			sink += properties.get<std::string>(*it, stringValue);
+		}
+
+		printResult(std::cout, "CProperties::get<std::string>", sizes[s], iterations, timer.getElapsedSeconds());
+	}
+}
+
+/**
+CEntityProperties::get walks through the archetype chain until it finds the property.
+Every archetype in the chain defines the component, but only the last one defines the
+property we ask for, which is the worst case.
+*/
+static void benchmarkArchetypeChain(unsigned int iterations) {
+	const unsigned int depths[] = { 0, 1, 4, 16 };
+	Samples::Components::CLight light;
+
+	for(unsigned int d = 0; d < sizeof(depths) / sizeof(depths[0]); ++d) {
+		// the chain can't be resized, or parent pointers would be invalidated
+		std::vector<CEntityProperties> chain(depths[d] + 1);
+
+		for(unsigned int i = 0; i <= depths[d]; ++i) {
+			CLevelEntry entry;
+			entry.type = "Benchmark";
+
+			if(i == depths[d]) {
+				entry.componentData[light.getName()].put("color", "1 0.5 0");
+			} else {
+				entry.componentData[light.getName()].put("type", "Directional");
+				chain[i].setParent(&chain[i + 1]);
+			}
+
+			chain[i].setData(entry);
+		}
+
+		CTimer timer;
+		Vector3 color;
+
+		for(unsigned int i = 0; i < iterations; ++i) {
+			sink += chain[0].get<Vector3>(&light, "color", color);
+		}
+
+		printResult(std::cout, "CEntityProperties::get (chain depth)", depths[d], iterations, timer.getElapsedSeconds());
+	}
+}
+
+/**
+CPool::releaseMessage looks for the released message in the list of messages in use,
+so its cost depends on how many messages are in use at the same time.
+*/
+static void benchmarkPool(unsigned int iterations) {
+	const unsigned int sizes[] = { 0, 100, 10000 };
+	Messages::CPool &pool = Messages::CPool::getInstance();
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		// keep some messages in use while measuring
+		std::vector<Messages::CMessage *> inUse;
+
+		for(unsigned int i = 0; i < sizes[s]; ++i) {
+			inUse.push_back(pool.obtainMessage<Samples::Messages::CSetPosition>());
+		}
+
+		CTimer timer;
+
+		for(unsigned int i = 0; i < iterations; ++i) {
+			Messages::CMessage *message = pool.obtainMessage<Samples::Messages::CSetPosition>();
+			pool.releaseMessage(message);
+		}
+
+		printResult(std::cout, "CPool::obtainMessage+releaseMessage", sizes[s], iterations, timer.getElapsedSeconds());
+
+		FOR_IT_CONST(std::vector<Messages::CMessage *>, it, inUse) {
+			pool.releaseMessage(*it);
+		}
+	}
+}
+
+/**
+CMessageTopic::suscribe and sendMessage, with a level-sized amount of suscribed entities.
+*/
+static void benchmarkMessageTopic(unsigned int iterations) {
+	const unsigned int sizes[] = { 100, 10000, 100000 };
+	Messages::CPool &pool = Messages::CPool::getInstance();
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Messages::CMessageTopic topic;
+		std::vector<IComponent *> components;
+		Messages::CWishList wishList;
+
+		for(unsigned int i = 0; i < sizes[s]; ++i) {
+			IComponent *component = new Samples::Components::CLight();
+			component->setEntity(i);
+			components.push_back(component);
+		}
+
+		// suscribe every component
+		CTimer timer;
+
+		FOR_IT_CONST(std::vector<IComponent *>, it, components) {
+			(*it)->populateWishList(wishList);
+			topic.suscribe(*it, wishList);
+			wishList.clear();
+		}
+
+		printResult(std::cout, "CMessageTopic::suscribe", sizes[s], sizes[s], timer.getElapsedSeconds());
+
+		// messages are sent in batches, which are processed (and returned to the pool) before
+		// sending the next one, since the pool gets slower the more messages are in use
+		std::vector<unsigned int> destinations;
+		generateIndices(iterations, sizes[s], destinations);
+		std::vector<Messages::CMessage *> messages;
+		double secs = 0.0;
+
+		for(unsigned int batch = 0; batch < iterations; batch += MESSAGE_BATCH_SIZE) {
+			unsigned int batchEnd = std::min<unsigned int>(batch + MESSAGE_BATCH_SIZE, iterations);
+
+			// obtain messages beforehand, we only want to measure sendMessage
+			messages.clear();
+
+			for(unsigned int i = batch; i < batchEnd; ++i) {
+				messages.push_back(pool.obtainMessage<Samples::Messages::CSetPosition>()->init(Vector3(1.0f, 0.0f, 0.0f)));
+			}
+
+			timer.start();
+
+			for(unsigned int i = batch; i < batchEnd; ++i) {
+				sink += topic.sendMessage(destinations[i], messages[i - batch], NULL);
+			}
+
+			secs += timer.getElapsedSeconds();
+
+			for(unsigned int i = batch; i < batchEnd; ++i) {
+				components[destinations[i]]->doTick(0.0f);
+			}
+		}
+
+		printResult(std::cout, "CMessageTopic::sendMessage", sizes[s], iterations, secs);
+
+		FOR_IT_CONST(std::vector<IComponent *>, it, components) {
+			delete *it;
+		}
+	}
+}
+
+/**
+CLevel::getComponent<T> looks the component up by its type ID in the entity's index.
+Entities have three components, and the one we look for has the lowest priority.
+*/
+static void benchmarkGetComponent(unsigned int iterations) {
+	const unsigned int sizes[] = { 100, 10000, 100000 };
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		CLevel level;
+
+		std::vector<TEntityID> ids;
+
+		for(unsigned int i = 0; i < sizes[s]; ++i) {
+			std::vector<IComponent *> components;
+			components.push_back(new Samples::Components::CPerception());
+			components.push_back(new Samples::Components::CLight());
+			components.push_back(new Samples::Components::CGraphics());
+
+			ids.push_back(addTestEntity(level, components));
+		}
+
+		std::vector<unsigned int> indices;
+		generateIndices(iterations, sizes[s], indices);
+		std::vector<TEntityID> entities(iterations);
+
+		for(unsigned int i = 0; i < iterations; ++i) {
+			entities[i] = ids[indices[i]];
+		}
+
+		CTimer timer;
+
+		FOR_IT_CONST(std::vector<TEntityID>, it, entities) {
+			sink += level.getComponent<Samples::Components::CGraphics>(*it) != NULL;
+		}
+
+		printResult(std::cout, "CLevel::getComponent<T>", sizes[s], iterations, timer.getElapsedSeconds());
+	}
+}
+
+/**
+Walking every entity with some components, looking them up entity by entity with
+CLevel::getComponent<T>, or through a cached CLevel::query. Only half of the entities
+have both components. Results are per entity in the level.
+*/
+static void benchmarkQuery(unsigned int iterations) {
+	const unsigned int sizes[] = { 100, 10000, 100000 };
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		CLevel level;
+		std::vector<TEntityID> ids;
+
+		for(unsigned int i = 0; i < sizes[s]; ++i) {
+			std::vector<IComponent *> components;
+			components.push_back(new Samples::Components::CGraphics());
+
+			if(i % 2 == 0) {
+				components.push_back(new Samples::Components::CLight());
+			}
+
+			ids.push_back(addTestEntity(level, components));
+		}
+
+		// walk the level as many times as needed to reach the iterations
+		unsigned int passes = std::max<unsigned int>(iterations / sizes[s], 1);
+		CTimer timer;
+
+		for(unsigned int pass = 0; pass < passes; ++pass) {
+			FOR_IT_CONST(std::vector<TEntityID>, it, ids) {
+				Samples::Components::CGraphics *graphics = level.getComponent<Samples::Components::CGraphics>(*it);
+				Samples::Components::CLight *light = level.getComponent<Samples::Components::CLight>(*it);
+				sink += graphics != NULL && light != NULL;
+			}
+		}
+
+		printResult(std::cout, "CLevel::getComponent<T> per entity", sizes[s], passes * sizes[s], timer.getElapsedSeconds());
+
+		timer.start();
+
+		for(unsigned int pass = 0; pass < passes; ++pass) {
+			CEntityQuery &query = level.query<Samples::Components::CGraphics, Samples::Components::CLight>();
+
+			for(CEntityQuery::CIterator it = query.begin(); !it.isEnd(); it.next()) {
+				sink += it.getComponent<Samples::Components::CGraphics>() != NULL;
+			}
+		}
+
+		printResult(std::cout, "CLevel::query", sizes[s], passes * sizes[s], timer.getElapsedSeconds());
+	}
+}
+
+/**
+Deleting entities in bulk, as high churn (projectiles, effects) does: every entity of the
+level is requested to be deleted, and the next tick really deletes them. Entities have a
+single component, which doesn't do anything when ticked. Results are per deleted entity.
+*/
+static void benchmarkDeferredDeletion(unsigned int iterations) {
+	const unsigned int sizes[] = { 100, 10000, 100000 };
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		CLevel level;
+		level.initialize();
+
+		// fill and empty the level as many times as needed to reach the iterations
+		unsigned int passes = std::max<unsigned int>(iterations / sizes[s], 1);
+		std::vector<TEntityID> ids(sizes[s]);
+		double secs = 0.0;
+
+		for(unsigned int pass = 0; pass < passes; ++pass) {
+			for(unsigned int i = 0; i < sizes[s]; ++i) {
+				ids[i] = addTestEntity(level, std::vector<IComponent *>(1, new Samples::Components::CPerception()));
+			}
+
+			CTimer timer;
+
+			FOR_IT_CONST(std::vector<TEntityID>, it, ids) {
+				level.deferDeleteEntity(*it);
+			}
+
+			level.tick(0.0f);
+			secs += timer.getElapsedSeconds();
+			sink += level.getEntityCount();
+		}
+
+		printResult(std::cout, "CLevel::deferDeleteEntity", sizes[s], passes * sizes[s], secs);
+	}
+}
+
+/**
+Component which only holds data, declared as every other component, so its level still
+passes the tick to it every frame.
+*/
+class CDataComponent : public IComponent {
+	DECLARE_COMPONENT(CDataComponent);
+
+public:
+	/**
+	Some data, like a position.
+	*/
+	Vector3 value;
+};
+
+IMPLEMENT_COMPONENT(CDataComponent);
+REGISTER_COMPONENT(CDataComponent);
+
+/**
+The same component, but declared as doing nothing every frame.
+*/
+class CPassiveDataComponent : public IComponent {
+	DECLARE_COMPONENT_TRAITS(CPassiveDataComponent, IComponent::TRAIT_NONE);
+
+public:
+	/**
+	Some data, like a position.
+	*/
+	Vector3 value;
+};
+
+IMPLEMENT_COMPONENT(CPassiveDataComponent);
+REGISTER_COMPONENT(CPassiveDataComponent);
+
+/**
+Ticking a level whose entities have four components which only hold data, declared as
+every other component or as doing nothing every frame. Results are per entity in the level.
+*/
+template <typename T>
+static void benchmarkDataComponents(unsigned int iterations, const std::string &primitive) {
+	const unsigned int sizes[] = { 100, 10000, 100000 };
+
+	for(unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		CLevel level;
+
+		for(unsigned int i = 0; i < sizes[s]; ++i) {
+			std::vector<IComponent *> components;
+
+			for(unsigned int j = 0; j < 4; ++j) {
+				components.push_back(new T());
+			}
+
+			addTestEntity(level, components);
+		}
+
+		level.initialize();
+		level.activate();
+
+		// tick the level as many times as needed to reach the iterations
+		unsigned int passes = std::max<unsigned int>(iterations / sizes[s], 1);
+		CTimer timer;
+
+		for(unsigned int pass = 0; pass < passes; ++pass) {
+			level.tick(0.0f);
+		}
+
+		printResult(std::cout, primitive, sizes[s], passes * sizes[s], timer.getElapsedSeconds());
+		level.deactivate();
+	}
+}
+
+/**
+Entry point of the microbenchmarks, which measure on their own the primitives every
+frame of the EvolvedPlus architecture leans on, across realistic sizes.
+It must be executed from the same directory as the sample application, since the
+config and message files are needed to bring the architecture up.
+
+Usage: Microbenchmark [-iterations <count>]
+By default every primitive is executed 100k times for each size.
+*/
+int main(int argc, char **argv) {
+	unsigned int iterations = DEFAULT_ITERATION_COUNT;
+
+	// parse the command line
+	for(int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+
+		if(argument == "-iterations" && i + 1 < argc) {
+			iterations = std::atoi(argv[++i]);
+		}
+	}
+
+	// bring every subsystem up, components and messages need their factories
+	EvolvedPlus::CApplication::getInstance();
+
+	printHeader(std::cout);
+	benchmarkProperties(iterations);
+	benchmarkArchetypeChain(iterations);
+	benchmarkPool(iterations);
+	benchmarkMessageTopic(iterations);
+	benchmarkGetComponent(iterations);
+	benchmarkQuery(iterations);
+	benchmarkDeferredDeletion(iterations);
+	benchmarkDataComponents<CDataComponent>(iterations, "CLevel::tick with data components");
+	benchmarkDataComponents<CPassiveDataComponent>(iterations, "CLevel::tick with TRAIT_NONE components");
+
+	EvolvedPlus::CApplication::release();
+
+	return 0;
+}
\ No newline at end of file
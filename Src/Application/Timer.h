@@ -0,0 +1,85 @@
+#ifndef Application_Timer_H
+#define Application_Timer_H
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace Application {
+
+	/**
+	Very basic high resolution timer, used to measure how long some parts of the
+	architecture take to execute.
+	It reads a monotonic clock, so it's safe to use it to measure intervals even if
+	the system time changes during the execution.
+	*/
+	class CTimer {
+	private:
+		/**
+		Time at which the timer was started, in seconds.
+		*/
+		double _start;
+
+	public:
+		/**
+		Default constructor, starts the timer right away.
+		*/
+		CTimer() : _start(getSeconds()) {
+
+		}
+
+		/**
+		Default destructor.
+		*/
+		~CTimer() {
+
+		}
+
+		/**
+		Starts (or restarts) the timer.
+		*/
+		void start() {
+			_start = getSeconds();
+		}
+
+		/**
+		Gets the time elapsed since the timer was started, in seconds.
+		*/
+		double getElapsedSeconds() const {
+			return getSeconds() - _start;
+		}
+
+		/**
+		Gets the current value of the monotonic clock, in seconds.
+		Its origin is arbitrary, so it only makes sense to compare two of its values.
+		*/
+		static double getSeconds() {
+#ifdef _WIN32
+			LARGE_INTEGER frequency;
+			LARGE_INTEGER counter;
+			QueryPerformanceFrequency(&frequency);
+			QueryPerformanceCounter(&counter);
+
+			return static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart);
+#else
+			timespec now;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+
+			return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+#endif
+		}
+	};
+
+}
+
+typedef Application::CTimer CTimer;
+
+#endif
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "Classic/Application.h"
 #include "Evolved/Application.h"
 #include "EvolvedPlus/Application.h"
@@ -13,8 +15,15 @@ comment out an approach totally: by the way components are registered into their
 we need to release those factories so everything is cleared. That's why every
 application.release() is important and can't be removed, or else leaks will appear.
 @see Component.h, Message.h to get more info on this restriction.
+
+Launching it with -headless skips the sample executions and soak-runs every approach
+instead, ticking each level until the limits in the config are reached and reporting
+frame times at exit.
 */
 int main(int argc, char **argv) {
+	// should we run the sample executions or soak-run every approach?
+	bool headless = argc > 1 && std::string(argv[1]) == "-headless";
+
 	// Classic approach
 	{
 		// build the application
@@ -22,7 +31,11 @@ int main(int argc, char **argv) {
 
 		// initialize it and run if initialization was successful
 		if(application.initialize()) {
-			application.run();
+			if(headless) {
+				application.runHeadless();
+			} else {
+				application.run();
+			}
 		}
 
 		// finally, destroy the application
@@ -36,7 +49,11 @@ int main(int argc, char **argv) {
 
 		// initialize it and run if initialization was successful
 		if(application.initialize()) {
-			application.run();
+			if(headless) {
+				application.runHeadless();
+			} else {
+				application.run();
+			}
 		}
 
 		// finally, destroy the application
@@ -50,7 +67,11 @@ int main(int argc, char **argv) {
 
 		// initialize it and run if initialization was successful
 		if(application.initialize()) {
-			application.run();
+			if(headless) {
+				application.runHeadless();
+			} else {
+				application.run();
+			}
 		}
 
 		// finally, destroy the application
@@ -1,9 +1,15 @@
 #include "Application.h"
 
+#include <iostream>
+#include <fstream>
+#include <string>
+
 #include "Components/ComponentFactory.h"
 #include "Entity/EntityFactory.h"
 #include "Level/LevelFactory.h"
 #include "Level/Level.h"
+#include "Application/Timer.h"
+#include "Application/FrameStatistics.h"
 
 // these next includes exist because of our sample test
 #include "Entity/Entity.h"
@@ -13,11 +19,35 @@ namespace Classic {
 
 #define LEVEL_TO_BUILD "Level.txt"
 #define GAME_LOOP_MAX_REPETITIONS 1
+#define GAME_LOOP_MAX_DURATION 0.0f
 #define CONTROLLED_DELTA_TIME 0.16f
+#define CONFIG_FILE "Configuration.txt"
+
+	/**
+	This architecture has no config of its own, but a headless run must honor the same limits
+	as the rest of them to be comparable. So, this reads a single "<key> <value>" property
+	from the config file shared by the other architectures, if it's there.
+	*/
+	template <typename T>
+	static bool readConfigValue(const std::string &key, T &outValue) {
+		std::ifstream in(CONFIG_FILE);
+		std::string name;
+
+		while(in >> name) {
+			if(name == key) {
+				return !(in >> outValue).fail();
+			}
+
+			// skip the value of any other property
+			std::getline(in, name);
+		}
+
+		return false;
+	}
 
 	CApplication *CApplication::_instance = NULL;
 
-	CApplication::CApplication() {
+	CApplication::CApplication() : _currentLevel(NULL) {
 		// initialize every subsystem in the architecture
 		CComponentFactory::getInstance();
 		CEntityFactory::getInstance();
@@ -70,21 +100,8 @@ namespace Classic {
 		However, for the sake of simplicity and the scope of this architecture,
 		we keep it under control and declare how many ticks will be
 		performed and the delta time, so our tests are easier to maintain.
-		*/
-
-		/*
-		int loopCount = 0;
-
-		while(loopCount < GAME_LOOP_MAX_REPETITIONS) {
-			// tick our level with a controlled delta time
-			_currentLevel->tick(CONTROLLED_DELTA_TIME);
-
-			// clean entities which were scheduled to be deleted
-			CEntityFactory::getInstance().deletePendingEntities();
-
-			// next loop
-			loopCount++;
-		}
+		A real loop like that one, which honors the limits defined above, is
+		available through runHeadless().
 		*/
 
 		{
@@ -110,6 +127,54 @@ namespace Classic {
 		_currentLevel->deactivate();
 	}
 
+	void CApplication::runHeadless() {
+		// extract our limits from the config file, a limit of 0 means there's no limit
+		unsigned int maxRepetitions = GAME_LOOP_MAX_REPETITIONS;
+		float maxDuration = GAME_LOOP_MAX_DURATION;
+		float deltaTime = CONTROLLED_DELTA_TIME;
+
+		readConfigValue<unsigned int>("game_loop_max_repetitions", maxRepetitions);
+		readConfigValue<float>("game_loop_max_duration", maxDuration);
+		readConfigValue<float>("controlled_delta_time", deltaTime);
+
+		// we need at least one limit, or we'd never stop
+		if(maxRepetitions == 0 && maxDuration <= 0.0f) {
+			std::cerr << "[Classic] a headless run needs a number of frames or a duration" << std::endl;
+			return;
+		}
+
+		// activate the level, before we can start
+		_currentLevel->activate();
+
+		CFrameStatistics statistics;
+		statistics.reserve(maxRepetitions);
+
+		CTimer runTimer;
+		CTimer frameTimer;
+		unsigned int loopCount = 0;
+
+		while((maxRepetitions == 0 || loopCount < maxRepetitions) &&
+		      (maxDuration <= 0.0f || runTimer.getElapsedSeconds() < maxDuration)) {
+			frameTimer.start();
+
+			// tick our level with a controlled delta time
+			_currentLevel->tick(deltaTime);
+
+			// clean entities which were scheduled to be deleted
+			CEntityFactory::getInstance().deletePendingEntities();
+
+			statistics.addFrame(frameTimer.getElapsedSeconds());
+
+			// next loop
+			loopCount++;
+		}
+
+		// deactivate it, as part of its life cycle
+		_currentLevel->deactivate();
+
+		statistics.report(std::cout, "Classic", _currentLevel->getEntityCount());
+	}
+
 	void CApplication::release() {
 		if(_instance) {
 			delete _instance;
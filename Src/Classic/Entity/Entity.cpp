@@ -1,6 +1,7 @@
 #include "Entity.h"
 #include "Classic/Components/Component.h"
 #include "Classic/Messages/Message.h"
+#include "Classic/Level/Level.h"
 #include "Application/Macros.h"
 
 namespace Classic {
@@ -37,6 +38,11 @@ namespace Classic {
 			_active = (*it)->activate() || _active;
 		}
 
+		// our level only ticks active entities
+		if(_level) {
+			_level->updateEntityActive(this);
+		}
+
 		return _active;
 	}
 
@@ -46,9 +52,17 @@ namespace Classic {
 		FOR_IT_CONST(TComponents, it, _components) {
 			(*it)->deactivate();
 		}
+
+		if(_level) {
+			_level->updateEntityActive(this);
+		}
 	}
 
 	void CEntity::tick(float secs) {
+		if(!_active) {
+			return;
+		}
+
 		FOR_IT_CONST(TComponents, it, _components) {
 			(*it)->doTick(secs);
 		}
@@ -108,7 +122,13 @@ namespace Classic {
 	}
 
 	void CEntity::setName(const std::string &name) {
+		std::string previousName = _name;
 		_name = name;
+
+		// our level keeps its entities indexed by name
+		if(_level) {
+			_level->updateEntityName(this, previousName);
+		}
 	}
 
 	TEntityID CEntity::getID() const {
@@ -108,7 +108,7 @@ namespace Classic {
 		void deactivate();
 
 		/**
-		Called every frame, this method is a bridge to component's tick.
+		Called every frame while the entity is active, this method is a bridge to component's tick.
 		*/
 		void tick(float secs);
 
@@ -147,6 +147,7 @@ namespace Classic {
 
 		/**
 		Sets the name of this entity.
+		Once spawned, its level is told about it so it can find the entity by its new name.
 		*/
 		void setName(const std::string &name);
 
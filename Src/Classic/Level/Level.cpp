@@ -1,11 +1,13 @@
 #include "Level.h"
 
+#include <algorithm>
+
 #include "Classic/Entity/Entity.h"
 #include "Application/Macros.h"
 
 namespace Classic {
 
-	CLevel::CLevel() : _initialized(false) {
+	CLevel::CLevel() : _ticking(false), _activeEntitiesHoles(false), _initialized(false) {
 
 	}
 
@@ -52,8 +54,20 @@ namespace Classic {
 	void CLevel::tick(float secs) {
 		assert(_initialized && "A level can't receive tick before being initialized.");
 
-		FOR_IT_CONST(TEntities, it, _entities) {
-			(*it)->tick(secs);
+		_ticking = true;
+
+		// by index, since an entity could activate more of them while ticking
+		for(unsigned int i = 0; i < _activeEntities.size(); ++i) {
+			// it was deactivated while ticking
+			if(_activeEntities[i] != NULL) {
+				_activeEntities[i]->tick(secs);
+			}
+		}
+
+		_ticking = false;
+
+		if(_activeEntitiesHoles) {
+			packActiveEntities();
 		}
 	}
 
@@ -62,6 +76,7 @@ namespace Classic {
 
 		if(it == _entities.end()) {
 			_entities.push_back(entity);
+			indexEntityName(entity->getName(), entity);
 
 			// also, store the data for this entity for the second step of initialization
 			_entitiesData[entity->getID()] = data;
@@ -76,6 +91,8 @@ namespace Classic {
 
 		if(it != _entities.end()) {
 			_entities.erase(it);
+			unindexEntityName(entity->getName(), entity);
+			removeActiveEntity(entity);
 			return true;
 		}
 
@@ -83,13 +100,28 @@ namespace Classic {
 	}
 
 	CEntity *CLevel::getEntityByName(const std::string &name) const {
-		FOR_IT_CONST(TEntities, it, _entities) {
-			if((*it)->getName() == name) {
-				return *it;
-			}
+		TEntityNames::const_iterator it = _entityNames.find(name);
+
+		return it != _entityNames.end() ? it->second : NULL;
+	}
+
+	void CLevel::updateEntityName(CEntity *entity, const std::string &previousName) {
+		// unnamed entities aren't indexed, so we have to make sure this one is in the level
+		bool inLevel = previousName.empty() ?
+		               std::find(_entities.begin(), _entities.end(), entity) != _entities.end() :
+		               unindexEntityName(previousName, entity);
+
+		if(inLevel) {
+			indexEntityName(entity->getName(), entity);
 		}
+	}
 
-		return NULL;
+	void CLevel::updateEntityActive(CEntity *entity) {
+		if(entity->isActive()) {
+			addActiveEntity(entity);
+		} else {
+			removeActiveEntity(entity);
+		}
 	}
 
 	CEntity *CLevel::getEntityByID(TEntityID id) const {
@@ -102,6 +134,18 @@ namespace Classic {
 		return NULL;
 	}
 
+	unsigned int CLevel::getEntityCount() const {
+		return _entities.size();
+	}
+
+	unsigned int CLevel::getActiveEntityCount() const {
+		return _activePositions.size();
+	}
+
+	void CLevel::getEntities(std::vector<CEntity *> &outEntities) const {
+		outEntities.insert(outEntities.end(), _entities.begin(), _entities.end());
+	}
+
 	void CLevel::destroyAllEntities() {
 		FOR_IT_CONST(TEntities, it, _entities) {
 			delete *it;
@@ -109,6 +153,77 @@ namespace Classic {
 
 		_entities.clear();
 		_entitiesData.clear();
+		_entityNames.clear();
+		_activeEntities.clear();
+		_activePositions.clear();
+		_activeEntitiesHoles = false;
+	}
+
+	void CLevel::addActiveEntity(CEntity *entity) {
+		if(_activePositions.find(entity) == _activePositions.end()) {
+			_activePositions[entity] = _activeEntities.size();
+			_activeEntities.push_back(entity);
+		}
+	}
+
+	void CLevel::removeActiveEntity(CEntity *entity) {
+		TActivePositions::iterator it = _activePositions.find(entity);
+
+		if(it == _activePositions.end()) {
+			return;
+		}
+
+		unsigned int position = it->second;
+		_activePositions.erase(it);
+
+		// while ticking, moving the last entity would make it skip its tick
+		if(_ticking) {
+			_activeEntities[position] = NULL;
+			_activeEntitiesHoles = true;
+			return;
+		}
+
+		CEntity *last = _activeEntities.back();
+		_activeEntities[position] = last;
+		_activeEntities.pop_back();
+
+		if(last != entity) {
+			_activePositions[last] = position;
+		}
+	}
+
+	void CLevel::packActiveEntities() {
+		unsigned int packed = 0;
+
+		FOR_IT_CONST(TEntities, it, _activeEntities) {
+			if(*it != NULL) {
+				_activePositions[*it] = packed;
+				_activeEntities[packed++] = *it;
+			}
+		}
+
+		_activeEntities.resize(packed);
+		_activeEntitiesHoles = false;
+	}
+
+	void CLevel::indexEntityName(const std::string &name, CEntity *entity) {
+		if(!name.empty()) {
+			_entityNames.insert(TEntityNames::value_type(name, entity));
+		}
+	}
+
+	bool CLevel::unindexEntityName(const std::string &name, CEntity *entity) {
+		// several entities might share the same name
+		std::pair<TEntityNames::iterator, TEntityNames::iterator> range = _entityNames.equal_range(name);
+
+		for(TEntityNames::iterator it = range.first; it != range.second; ++it) {
+			if(it->second == entity) {
+				_entityNames.erase(it);
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <map>
+#include <string>
+#include <unordered_map>
 
 #include "Classic/Entity/EntityID.h"
 #include "Classic/Level/LevelData.h"
@@ -31,6 +33,33 @@ namespace Classic {
 		*/
 		TEntities _entities;
 
+		/**
+		Every active entity in this level, packed together so ticking only goes through those.
+		Entities deactivated while ticking leave a hole (NULL) behind, which is removed once
+		the tick is over.
+		*/
+		TEntities _activeEntities;
+
+		/**
+		Alias for the position of entities in the list of active entities.
+		*/
+		typedef std::unordered_map<CEntity *, unsigned int> TActivePositions;
+
+		/**
+		Where every active entity is within _activeEntities.
+		*/
+		TActivePositions _activePositions;
+
+		/**
+		Whether entities are being ticked right now.
+		*/
+		bool _ticking;
+
+		/**
+		Whether _activeEntities has holes which have to be removed.
+		*/
+		bool _activeEntitiesHoles;
+
 		/**
 		Data for all entities in the level, when the level is built.
 		*/
@@ -41,11 +70,48 @@ namespace Classic {
 		*/
 		TEntitiesData _entitiesData;
 
+		/**
+		Alias for the index of entities by name.
+		*/
+		typedef std::unordered_multimap<std::string, CEntity *> TEntityNames;
+
+		/**
+		Every named entity in the level, indexed by its name, so looking for them is O(1).
+		Entities without a name aren't indexed.
+		*/
+		TEntityNames _entityNames;
+
 		/**
 		Flag which stores whether or not the level has been initialized already.
 		*/
 		bool _initialized;
 
+		/**
+		Adds an entity to the index of names.
+		*/
+		void indexEntityName(const std::string &name, CEntity *entity);
+
+		/**
+		Removes an entity from the index of names, returning whether it was there.
+		*/
+		bool unindexEntityName(const std::string &name, CEntity *entity);
+
+		/**
+		Adds an entity to the list of active entities, if it isn't there already.
+		*/
+		void addActiveEntity(CEntity *entity);
+
+		/**
+		Takes an entity out of the list of active entities, moving the last one into its
+		place (or leaving a hole, while ticking).
+		*/
+		void removeActiveEntity(CEntity *entity);
+
+		/**
+		Removes the holes of the list of active entities, keeping their order.
+		*/
+		void packActiveEntities();
+
 		/**
 		Destroys every entity in the level, to be used when the level is destroyed.
 		*/
@@ -80,7 +146,7 @@ namespace Classic {
 		void deactivate();
 
 		/**
-		Called once per frame, it will pass the tick to every entity in the level.
+		Called once per frame, it will pass the tick to every active entity in the level.
 		*/
 		void tick(float secs);
 
@@ -96,13 +162,42 @@ namespace Classic {
 
 		/**
 		Retrieves an entity by name.
+		If several entities share the same name, any of them might be returned.
 		*/
 		CEntity *getEntityByName(const std::string &name) const;
 
+		/**
+		Keeps the index of names up to date when an entity in this level is renamed.
+		Called by the entity itself.
+		*/
+		void updateEntityName(CEntity *entity, const std::string &previousName);
+
+		/**
+		Keeps the list of active entities up to date when an entity in this level is
+		activated or deactivated, so only active entities are ticked.
+		Called by the entity itself.
+		*/
+		void updateEntityActive(CEntity *entity);
+
 		/**
 		Retrieves an entity by its unique identifier.
 		*/
 		CEntity *getEntityByID(TEntityID id) const;
+
+		/**
+		Gets how many entities are in the level.
+		*/
+		unsigned int getEntityCount() const;
+
+		/**
+		Gets how many active entities are in the level.
+		*/
+		unsigned int getActiveEntityCount() const;
+
+		/**
+		Fills the given list with every entity in the level.
+		*/
+		void getEntities(std::vector<CEntity *> &outEntities) const;
 	};
 
 }
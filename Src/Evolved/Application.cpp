@@ -1,11 +1,16 @@
 #include "Application.h"
 
+#include <cassert>
+#include <iostream>
+
 #include "Components/ComponentFactory.h"
 #include "Entity/EntityFactory.h"
 #include "Level/LevelFactory.h"
 #include "Level/Level.h"
 #include "Messages/Pool.h"
 #include "Config/Config.h"
+#include "Application/Timer.h"
+#include "Application/FrameStatistics.h"
 
 // these next includes exist because of our sample test
 #include "Samples/Messages/SetPosition.h"
@@ -14,7 +19,7 @@ namespace Evolved {
 
 	CApplication *CApplication::_instance = NULL;
 
-	CApplication::CApplication() {
+	CApplication::CApplication() : _currentLevel(NULL) {
 		// initialize every subsystem in the architecture
 		Messages::CPool::getInstance().initialize();
 		CComponentFactory::getInstance();
@@ -77,18 +82,8 @@ namespace Evolved {
 		However, for the sake of simplicity and the scope of this architecture,
 		we keep it under control and declare how many ticks will be
 		performed and the delta time, so our tests are easier to maintain.
-		*/
-
-		/*
-		int loopCount = 0;
-
-		while(loopCount < GAME_LOOP_MAX_REPETITIONS) {
-			// tick our level with a controlled delta time
-			_currentLevel->tick(CONTROLLED_DELTA_TIME);
-
-			// next loop
-			loopCount++;
-		}
+		A real loop like that one, which honors the limits in our config, is
+		available through runHeadless().
 		*/
 
 		{
@@ -122,6 +117,55 @@ namespace Evolved {
 		_currentLevel->deactivate();
 	}
 
+	void CApplication::runHeadless() {
+		// extract our limits from the config file, a limit of 0 means there's no limit
+		unsigned int maxRepetitions = 0;
+		float maxDuration = 0.0f;
+		float deltaTime;
+
+		CConfig &config = CConfig::getInstance();
+		config.get<unsigned int>("game_loop_max_repetitions", maxRepetitions);
+		config.get<float>("game_loop_max_duration", maxDuration);
+
+		if(!config.get<float>("controlled_delta_time", deltaTime)) {
+			deltaTime = 0.16f;
+		}
+
+		// we need at least one limit, or we'd never stop
+		if(maxRepetitions == 0 && maxDuration <= 0.0f) {
+			std::cerr << "[Evolved] a headless run needs a number of frames or a duration" << std::endl;
+			return;
+		}
+
+		// activate the level, before we can start
+		_currentLevel->activate();
+
+		CFrameStatistics statistics;
+		statistics.reserve(maxRepetitions);
+
+		CTimer runTimer;
+		CTimer frameTimer;
+		unsigned int loopCount = 0;
+
+		while((maxRepetitions == 0 || loopCount < maxRepetitions) &&
+		      (maxDuration <= 0.0f || runTimer.getElapsedSeconds() < maxDuration)) {
+			frameTimer.start();
+
+			// tick our level with a controlled delta time
+			_currentLevel->tick(deltaTime);
+
+			statistics.addFrame(frameTimer.getElapsedSeconds());
+
+			// next loop
+			loopCount++;
+		}
+
+		// deactivate it, as part of its life cycle
+		_currentLevel->deactivate();
+
+		statistics.report(std::cout, "Evolved", _currentLevel->getEntityCount());
+	}
+
 	void CApplication::release() {
 		if(_instance) {
 			delete _instance;
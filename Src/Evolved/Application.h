@@ -59,6 +59,13 @@ namespace Evolved {
 		*/
 		virtual void run();
 
+		/**
+		Runs the application without any kind of sample script: the level is ticked over
+		and over until a number of frames or a wall-clock duration is reached, whatever
+		happens first. Once it finishes, it reports how long frames took.
+		*/
+		virtual void runHeadless();
+
 		/**
 		When the singleton won't be used anymore, we can call this method to destroy the
 		current instance. This is the only way of destroying it and not calling it would
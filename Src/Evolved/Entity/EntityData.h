@@ -34,6 +34,12 @@ namespace Evolved {
 		*/
 		bool active;
 
+		/**
+		Where this entity is within the list of active entities of the level, while it's active.
+		It's kept up to date by the level.
+		*/
+		unsigned int activePosition;
+
 		/**
 		Entity's components.
 		*/
@@ -43,6 +49,13 @@ namespace Evolved {
 		Data defined in the level for this entity.
 		*/
 		CEntityProperties data;
+
+		/**
+		Default constructor, the entity starts inactive.
+		*/
+		CEntityData() : active(false), activePosition(0) {
+
+		}
 	};
 }
 
@@ -1,5 +1,7 @@
 #include "Level.h"
 
+#include <algorithm>
+
 #include "Evolved/Components/Component.h"
 #include "Evolved/Messages/Message.h"
 #include "Evolved/Messages/MessageTopic.h"
@@ -7,7 +9,8 @@
 
 namespace Evolved {
 
-	CLevel::CLevel() : _initialized(false), _messageTopic(new Messages::CMessageTopic()) {
+	CLevel::CLevel() : _ticking(false), _activeEntitiesHoles(false), _messageTopic(new Messages::CMessageTopic()),
+		_initialized(false) {
 
 	}
 
@@ -44,10 +47,18 @@ namespace Evolved {
 	bool CLevel::activate() {
 		assert(_initialized && "A level can't be activated before being initialized.");
 
+		// entities which were already active are already suscribed, and the ones we activate
+		// are added at the end of the list of active entities
+		unsigned int firstActivated = _activeEntities.size();
+
 		// iterate over entities (not using a constant iterator because we might have to save data)
 		FOR_IT(TEntities, itEntity, _entities) {
 			const CEntityData &data = itEntity->second;
 
+			if(data.active) {
+				continue;
+			}
+
 			// iterate over entity components and activate them
 			FOR_IT_CONST(TComponents, itComponent, data.components) {
 				if(!(*itComponent)->activate()) {
@@ -57,10 +68,11 @@ namespace Evolved {
 
 			// entity was activated correctly, so save that
 			itEntity->second.active = true;
+			addActiveEntity(itEntity->second);
 		}
 
 		// now that every component is activated, suscribe them all
-		suscribeEntities();
+		suscribeEntities(firstActivated);
 
 		return true;
 	}
@@ -71,30 +83,47 @@ namespace Evolved {
 		// unsuscribe components from our message topic
 		unsuscribeEntities();
 
-		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		// iterate over active entities
+		FOR_IT_CONST(TActiveEntities, itEntity, _activeEntities) {
+			CEntityData &data = **itEntity;
 
 			// iterate over entity components and deactivate them
 			FOR_IT_CONST(TComponents, itComponent, data.components) {
 				(*itComponent)->deactivate();
 			}
+
+			data.active = false;
 		}
+
+		_activeEntities.clear();
 	}
 
 	void CLevel::tick(float secs) {
 		assert(_initialized && "A level can't receive tick before being initialized.");
 
-		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		_ticking = true;
+
+		// iterate over active entities (by index, since a component could activate more of them)
+		for(unsigned int i = 0; i < _activeEntities.size(); ++i) {
+			const CEntityData *data = _activeEntities[i];
+
+			// it was deactivated while ticking
+			if(data == NULL) {
+				continue;
+			}
 
 			// iterate over entity components and pass the tick
-			FOR_IT_CONST(TComponents, itComponent, data.components) {
+			FOR_IT_CONST(TComponents, itComponent, data->components) {
 				(*itComponent)->doTick(secs);
 			}
 		}
 
+		_ticking = false;
+
+		if(_activeEntitiesHoles) {
+			packActiveEntities();
+		}
+
 		// now that every entity in the level has receive their tick, we can clean up
 		// pending entities which were requested to be deleted
 		deletePendingEntities();
@@ -106,6 +135,8 @@ namespace Evolved {
 		if(it == _entities.end()) {
 			// create a new entry
 			_entities[entity] = entityData;
+			_entities[entity].active = false;
+			indexEntityName(entityData.name, entity);
 
 			return true;
 		}
@@ -117,6 +148,12 @@ namespace Evolved {
 		TEntities::const_iterator it = _entities.find(entity);
 
 		if(it != _entities.end()) {
+			unindexEntityName(it->second.name, entity);
+
+			if(it->second.active) {
+				removeActiveEntity(it->second);
+			}
+
 			_entities.erase(it);
 			return true;
 		}
@@ -125,17 +162,9 @@ namespace Evolved {
 	}
 
 	TEntityID CLevel::getEntityByName(const std::string &name) const {
-		TEntityID entity = CEntityID::UNASSIGNED;
+		TEntityNames::const_iterator it = _entityNames.find(name);
 
-		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			if(itEntity->second.name == name) {
-				entity = itEntity->first;
-				break;
-			}
-		}
-
-		return entity;
+		return it != _entityNames.end() ? it->second : CEntityID::UNASSIGNED;
 	}
 
 	const std::string &CLevel::getEntityName(const TEntityID &entity) const {
@@ -149,7 +178,9 @@ namespace Evolved {
 		TEntities::iterator it = _entities.find(entity);
 		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
 
+		unindexEntityName(it->second.name, entity);
 		it->second.name = name;
+		indexEntityName(name, entity);
 	}
 
 	const std::string &CLevel::getEntityType(const TEntityID &entity) const {
@@ -173,6 +204,108 @@ namespace Evolved {
 		return it->second.active;
 	}
 
+	bool CLevel::setEntityActive(const TEntityID &entity, bool active) {
+		TEntities::iterator it = _entities.find(entity);
+		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
+
+		CEntityData &data = it->second;
+
+		if(data.active == active) {
+			return true;
+		}
+
+		if(active) {
+			// activate its components, and suscribe them once every one of them is activated
+			FOR_IT_CONST(TComponents, itComponent, data.components) {
+				if(!(*itComponent)->activate()) {
+					// leave the entity as it was, deactivating the ones which were already activated
+					while(itComponent != data.components.begin()) {
+						(*--itComponent)->deactivate();
+					}
+
+					return false;
+				}
+			}
+
+			Messages::CWishList wishList;
+
+			FOR_IT_CONST(TComponents, itComponent, data.components) {
+				(*itComponent)->populateWishList(wishList);
+				_messageTopic->suscribe(*itComponent, wishList);
+				wishList.clear();
+			}
+
+			data.active = true;
+			addActiveEntity(data);
+		} else {
+			// just the opposite, unsuscribe it and deactivate its components
+			_messageTopic->unsuscribe(entity);
+
+			FOR_IT_CONST(TComponents, itComponent, data.components) {
+				(*itComponent)->deactivate();
+			}
+
+			data.active = false;
+			removeActiveEntity(data);
+		}
+
+		return true;
+	}
+
+	unsigned int CLevel::getEntityCount() const {
+		return _entities.size();
+	}
+
+	unsigned int CLevel::getActiveEntityCount() const {
+		if(!_activeEntitiesHoles) {
+			return _activeEntities.size();
+		}
+
+		return _activeEntities.size() - std::count(_activeEntities.begin(), _activeEntities.end(),
+		                                           static_cast<CEntityData *>(NULL));
+	}
+
+	void CLevel::addActiveEntity(CEntityData &data) {
+		data.activePosition = _activeEntities.size();
+		_activeEntities.push_back(&data);
+	}
+
+	void CLevel::removeActiveEntity(const CEntityData &data) {
+		// while ticking, moving the last entity would make it skip its tick
+		if(_ticking) {
+			_activeEntities[data.activePosition] = NULL;
+			_activeEntitiesHoles = true;
+			return;
+		}
+
+		CEntityData *last = _activeEntities.back();
+		_activeEntities[data.activePosition] = last;
+		last->activePosition = data.activePosition;
+		_activeEntities.pop_back();
+	}
+
+	void CLevel::packActiveEntities() {
+		unsigned int packed = 0;
+
+		FOR_IT_CONST(TActiveEntities, itEntity, _activeEntities) {
+			if(*itEntity != NULL) {
+				(*itEntity)->activePosition = packed;
+				_activeEntities[packed++] = *itEntity;
+			}
+		}
+
+		_activeEntities.resize(packed);
+		_activeEntitiesHoles = false;
+	}
+
+	void CLevel::getEntities(std::vector<TEntityID> &outEntities) const {
+		outEntities.reserve(outEntities.size() + _entities.size());
+
+		FOR_IT_CONST(TEntities, itEntity, _entities) {
+			outEntities.push_back(itEntity->first);
+		}
+	}
+
 	void CLevel::destroyAllEntities() {
 		// iterate over entities
 		FOR_IT_CONST(TEntities, itEntity, _entities) {
@@ -185,6 +318,29 @@ namespace Evolved {
 		}
 
 		_entities.clear();
+		_entityNames.clear();
+		_activeEntities.clear();
+		_activeEntitiesHoles = false;
+	}
+
+	void CLevel::indexEntityName(const std::string &name, const TEntityID &entity) {
+		if(!name.empty()) {
+			_entityNames.insert(TEntityNames::value_type(name, entity));
+		}
+	}
+
+	bool CLevel::unindexEntityName(const std::string &name, const TEntityID &entity) {
+		// several entities might share the same name
+		std::pair<TEntityNames::iterator, TEntityNames::iterator> range = _entityNames.equal_range(name);
+
+		for(TEntityNames::iterator it = range.first; it != range.second; ++it) {
+			if(it->second == entity) {
+				_entityNames.erase(it);
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 	void CLevel::deferDeleteEntity(const TEntityID &entity) {
@@ -216,12 +372,12 @@ namespace Evolved {
 		return _messageTopic->sendMessage(destination, message, emitter);
 	}
 
-	void CLevel::suscribeEntities() {
+	void CLevel::suscribeEntities(unsigned int first) {
 		// temporal WishList to pass around components (we're reusing it, instead of creating more)
 		Messages::CWishList wishList;
 
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		for(unsigned int i = first; i < _activeEntities.size(); ++i) {
+			const CEntityData &data = *_activeEntities[i];
 
 			FOR_IT_CONST(TComponents, itComponent, data.components) {
 				// ask the component to tell which messages are important for it
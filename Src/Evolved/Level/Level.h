@@ -2,6 +2,8 @@
 #define Evolved_Level_H
 
 #include <vector>
+#include <string>
+#include <unordered_map>
 #include <map>
 
 #include "Evolved/Entity/EntityID.h"
@@ -45,6 +47,39 @@ namespace Evolved {
 		*/
 		TEntities _entities;
 
+		/**
+		Alias for the list of active entities.
+		*/
+		typedef std::vector<CEntityData *> TActiveEntities;
+
+		/**
+		Every active entity in this level, packed together so ticking only goes through those.
+		Entities deactivated while ticking leave a hole (NULL) behind, which is removed once
+		the tick is over.
+		*/
+		TActiveEntities _activeEntities;
+
+		/**
+		Whether entities are being ticked right now.
+		*/
+		bool _ticking;
+
+		/**
+		Whether _activeEntities has holes which have to be removed.
+		*/
+		bool _activeEntitiesHoles;
+
+		/**
+		Alias for the index of entities by name.
+		*/
+		typedef std::unordered_multimap<std::string, TEntityID> TEntityNames;
+
+		/**
+		Every named entity in the level, indexed by its name, so looking for them is O(1).
+		Entities without a name aren't indexed.
+		*/
+		TEntityNames _entityNames;
+
 		/**
 		Alias for a vector of entities which will be deleted.
 		*/
@@ -65,6 +100,32 @@ namespace Evolved {
 		*/
 		bool _initialized;
 
+		/**
+		Adds an entity to the index of names.
+		*/
+		void indexEntityName(const std::string &name, const TEntityID &entity);
+
+		/**
+		Removes an entity from the index of names, returning whether it was there.
+		*/
+		bool unindexEntityName(const std::string &name, const TEntityID &entity);
+
+		/**
+		Adds an entity to the list of active entities.
+		*/
+		void addActiveEntity(CEntityData &data);
+
+		/**
+		Takes an entity out of the list of active entities, moving the last one into its
+		place (or leaving a hole, while ticking).
+		*/
+		void removeActiveEntity(const CEntityData &data);
+
+		/**
+		Removes the holes of the list of active entities, keeping their order.
+		*/
+		void packActiveEntities();
+
 		/**
 		Destroys every entity in the level, to be used when the level is destroyed.
 		*/
@@ -76,9 +137,10 @@ namespace Evolved {
 		void deletePendingEntities();
 
 		/**
-		Creates suscriptions for every entity in the level.
+		Creates suscriptions for the active entities from the given position of the list
+		of active entities onwards.
 		*/
-		void suscribeEntities();
+		void suscribeEntities(unsigned int first);
 
 		/**
 		Destroys suscriptions for every entity in the level.
@@ -114,12 +176,13 @@ namespace Evolved {
 		void deactivate();
 
 		/**
-		Called once per frame, it will pass the tick to every entity in the level.
+		Called once per frame, it will pass the tick to every active entity in the level.
 		*/
 		void tick(float secs);
 
 		/**
 		Adds an entity to the level.
+		It's added inactive, and it's activated along with the level or through setEntityActive.
 		*/
 		bool addEntity(const TEntityID &entity, const CEntityData &entityData);
 
@@ -130,6 +193,7 @@ namespace Evolved {
 
 		/**
 		Retrieves an entity by name.
+		If several entities share the same name, any of them might be returned.
 		*/
 		TEntityID getEntityByName(const std::string &name) const;
 
@@ -158,6 +222,28 @@ namespace Evolved {
 		*/
 		bool isEntityActive(const TEntityID &entity) const;
 
+		/**
+		Activates or deactivates an entity in this level, returning whether it could be done.
+		Activating it activates its components and suscribes them to their messages, and
+		deactivating it does the opposite. Only active entities are ticked.
+		*/
+		bool setEntityActive(const TEntityID &entity, bool active);
+
+		/**
+		Gets how many entities are in the level.
+		*/
+		unsigned int getEntityCount() const;
+
+		/**
+		Gets how many active entities are in the level.
+		*/
+		unsigned int getActiveEntityCount() const;
+
+		/**
+		Fills the given list with the identifier of every entity in the level.
+		*/
+		void getEntities(std::vector<TEntityID> &outEntities) const;
+
 		/**
 		Arguably the most important method related to entities.
 		Since entities are just identifiers, we need to manage communications between
@@ -1,11 +1,23 @@
 #include "Application.h"
 
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
 #include "Components/ComponentFactory.h"
+#include "Components/ComponentStorage.h"
 #include "Entity/EntityFactory.h"
 #include "Level/LevelFactory.h"
 #include "Level/Level.h"
 #include "Messages/Pool.h"
+#include "Messages/MessageTopic.h"
 #include "Config/Config.h"
+#include "Profiling/ComponentProfiler.h"
+#include "Profiling/Tracer.h"
+#include "Profiling/StartupProfiler.h"
+#include "Profiling/AllocationTracker.h"
+#include "Application/Timer.h"
+#include "Application/FrameStatistics.h"
 
 // these next includes exist because of our sample test
 #include "Samples/Messages/SetPosition.h"
@@ -15,13 +27,20 @@ namespace EvolvedPlus {
 
 	CApplication *CApplication::_instance = NULL;
 
-	CApplication::CApplication() {
+	CApplication::CApplication() : _currentLevel(NULL) {
 		// initialize every subsystem in the architecture
 		Messages::CPool::getInstance().initialize();
 		CComponentFactory::getInstance();
 		CEntityFactory::getInstance();
 		CLevelFactory::getInstance();
 		CConfig::getInstance();
+
+#ifdef TRACE_FRAMES
+		// the tracer must exist before anything is recorded
+		unsigned int traceCapacity = TRACE_DEFAULT_CAPACITY;
+		CConfig::getInstance().get<unsigned int>("trace_capacity", traceCapacity);
+		Profiling::CTracer::getInstance().setCapacity(traceCapacity);
+#endif
 	}
 
 	CApplication::~CApplication() {
@@ -32,9 +51,17 @@ namespace EvolvedPlus {
 
 		// clean up every subsystem in the architecture
 		CConfig::release();
+		Profiling::CStartupProfiler::release();
+#ifdef PROFILE_COMPONENTS
+		Profiling::CComponentProfiler::release();
+#endif
+#ifdef TRACE_FRAMES
+		Profiling::CTracer::release();
+#endif
 		CEntityFactory::release();
 		CLevelFactory::release();
 		CComponentFactory::release();
+		CComponentStorage::release();
 		Messages::CPool::release();
 	}
 
@@ -67,6 +94,9 @@ namespace EvolvedPlus {
 		// activate the level, before we can start
 		_currentLevel->activate();
 
+		// the start up is over, levels loaded from now on aren't part of it
+		Profiling::CStartupProfiler::getInstance().finish();
+
 		/**
 		This game loop should be something similar to:
 
@@ -78,18 +108,8 @@ namespace EvolvedPlus {
 		However, for the sake of simplicity and the scope of this architecture,
 		we keep it under control and declare how many ticks will be
 		performed and the delta time, so our tests are easier to maintain.
-		*/
-
-		/*
-		int loopCount = 0;
-
-		while(loopCount < GAME_LOOP_MAX_REPETITIONS) {
-			// tick our level with a controlled delta time
-			_currentLevel->tick(CONTROLLED_DELTA_TIME);
-
-			// next loop
-			loopCount++;
-		}
+		A real loop like that one, which honors the limits in our config, is
+		available through runHeadless().
 		*/
 
 		{
@@ -148,27 +168,31 @@ namespace EvolvedPlus {
 				Graphics -> 1/60 (tick 60 times a second)
 				Perception -> 1/20 (tick 20 times a second)
 
+			Components which tick every time go first, entity by entity. Then, the scheduler ticks
+			the ones which are due, a group of components sharing a frequency after another (which
+			group goes first depends on their phases), catching up once per elapsed period.
+
 			[Light]         [Entity #0]     tick: 0.030000 ms
+			[Light]         [Entity #2]     tick: 0.030000 ms
 			[Graphics]      [Entity #0]     tick: 0.016667 ms
 			[Graphics]      [Entity #1]     tick: 0.016667 ms
-			[Light]         [Entity #2]     tick: 0.030000 ms
 			[Graphics]      [Entity #2]     tick: 0.016667 ms
 
-			[Perception]    [Entity #0]     tick: 0.050000 ms
 			[Light]         [Entity #0]     tick: 0.030000 ms
+			[Light]         [Entity #2]     tick: 0.030000 ms
+			[Perception]    [Entity #0]     tick: 0.050000 ms
 			[Perception]    [Entity #1]     tick: 0.050000 ms
 			[Graphics]      [Entity #1]     tick: 0.016667 ms
 			[Graphics]      [Entity #1]     tick: 0.016667 ms
-			[Light]         [Entity #2]     tick: 0.030000 ms
 			[Graphics]      [Entity #2]     tick: 0.016667 ms
 			[Graphics]      [Entity #2]     tick: 0.016667 ms
 
 			[Light]         [Entity #0]     tick: 0.030000 ms
+			[Light]         [Entity #2]     tick: 0.030000 ms
 			[Graphics]      [Entity #0]     tick: 0.016667 ms
 			[Graphics]      [Entity #0]     tick: 0.016667 ms
 			[Graphics]      [Entity #1]     tick: 0.016667 ms
 			[Graphics]      [Entity #1]     tick: 0.016667 ms
-			[Light]         [Entity #2]     tick: 0.030000 ms
 			[Graphics]      [Entity #2]     tick: 0.016667 ms
 			[Graphics]      [Entity #2]     tick: 0.016667 ms
 			*/
@@ -178,6 +202,169 @@ namespace EvolvedPlus {
 		_currentLevel->deactivate();
 	}
 
+	void CApplication::runHeadless() {
+		// extract our limits from the config file, a limit of 0 means there's no limit
+		unsigned int maxRepetitions = 0;
+		float maxDuration = 0.0f;
+		float deltaTime;
+
+		CConfig &config = CConfig::getInstance();
+		config.get<unsigned int>("game_loop_max_repetitions", maxRepetitions);
+		config.get<float>("game_loop_max_duration", maxDuration);
+
+		if(!config.get<float>("controlled_delta_time", deltaTime)) {
+			deltaTime = 0.16f;
+		}
+
+		// we need at least one limit, or we'd never stop
+		if(maxRepetitions == 0 && maxDuration <= 0.0f) {
+			std::cerr << "[EvolvedPlus] a headless run needs a number of frames or a duration" << std::endl;
+			return;
+		}
+
+#ifdef PROFILE_COMPONENTS
+		// frames slower than this threshold (in ms) get their own report, 0 means never
+		float spikeThreshold = 0.0f;
+		config.get<float>("profiler_spike_threshold", spikeThreshold);
+#endif
+
+		// frames which send more messages than this threshold get a messaging report, 0 means never
+		unsigned int messageStormThreshold = 0;
+		config.get<unsigned int>("message_storm_threshold", messageStormThreshold);
+
+#ifdef TRACK_ALLOCATIONS
+		// frames after the warm-up must not allocate, and a strict run fails as soon as one does
+		unsigned int allocationWarmupFrames = 1;
+		bool allocationStrict = false;
+		config.get<unsigned int>("allocation_warmup_frames", allocationWarmupFrames);
+		config.get<bool>("allocation_strict", allocationStrict);
+		Profiling::CAllocationTracker::setWarmupFrames(allocationWarmupFrames);
+#endif
+
+		Messages::CMessageTopic &messageTopic = _currentLevel->getMessageTopic();
+		messageTopic.setStatisticsEnabled(messageStormThreshold > 0);
+
+		// activate the level, before we can start
+		_currentLevel->activate();
+
+		// every phase of the start up is over, so tell which one took longer (levels loaded
+		// from now on aren't part of it)
+		Profiling::CStartupProfiler &startupProfiler = Profiling::CStartupProfiler::getInstance();
+		startupProfiler.finish();
+		startupProfiler.report(std::cout);
+
+		CFrameStatistics statistics;
+		statistics.reserve(maxRepetitions);
+
+		CTimer runTimer;
+		CTimer frameTimer;
+		unsigned int loopCount = 0;
+
+		// frames which ran out of frame budget and left components with a low priority for later
+		unsigned int overBudgetFrames = 0;
+
+		// frames in which components which can be slowed down were
+		unsigned int slowedDownFrames = 0;
+
+		while((maxRepetitions == 0 || loopCount < maxRepetitions) &&
+		      (maxDuration <= 0.0f || runTimer.getElapsedSeconds() < maxDuration)) {
+			frameTimer.start();
+
+			// tick our level with a controlled delta time
+			_currentLevel->tick(deltaTime);
+
+			// whatever is done from here on (statistics and reports) isn't part of any frame
+			TRACK_ALLOCATIONS_PAUSE();
+
+			double frameTime = frameTimer.getElapsedSeconds();
+			statistics.addFrame(frameTime);
+
+			if(_currentLevel->getDeferredComponentCount() > 0) {
+				overBudgetFrames++;
+			}
+
+			if(_currentLevel->getSlowdown() > 0) {
+				slowedDownFrames++;
+			}
+
+			// tell which messages and entities caused a message storm
+			if(messageStormThreshold > 0 && messageTopic.getStatistics().sent > messageStormThreshold) {
+				std::cout << "[EvolvedPlus] message storm in frame " << loopCount + 1 << std::endl;
+				messageTopic.reportStatistics(std::cout, 5);
+			}
+
+#ifdef TRACK_ALLOCATIONS
+			if(Profiling::CAllocationTracker::hasLastFrameViolated()) {
+				Profiling::CAllocationTracker::reportLastFrame(std::cout);
+
+				if(allocationStrict) {
+					std::cout << "[EvolvedPlus] a frame allocated memory after warming up, failing the run" << std::endl;
+					std::exit(EXIT_FAILURE);
+				}
+			}
+#endif
+
+#ifdef PROFILE_COMPONENTS
+			// tell which components made this frame spike
+			if(spikeThreshold > 0.0f && frameTime * 1000.0 > spikeThreshold) {
+				Profiling::CComponentProfiler::getInstance().writeFrameReport(std::cout);
+			}
+#endif
+
+			// next loop
+			loopCount++;
+		}
+
+		// deactivate it, as part of its life cycle
+		_currentLevel->deactivate();
+
+		statistics.report(std::cout, "EvolvedPlus", _currentLevel->getEntityCount());
+
+		if(_currentLevel->getFrameBudget() > 0.0f) {
+			std::cout << "[EvolvedPlus] " << overBudgetFrames << " frames ran out of their "
+			          << _currentLevel->getFrameBudget() << " ms budget" << std::endl;
+		}
+
+		if(slowedDownFrames > 0) {
+			std::cout << "[EvolvedPlus] components were slowed down in " << slowedDownFrames << " frames" << std::endl;
+		}
+
+		// tell whether the message pool had to grow, and size it for the next run if asked to
+		Messages::CPool &pool = Messages::CPool::getInstance();
+		std::cout << "[EvolvedPlus] message pool usage" << std::endl;
+		pool.reportUsage(std::cout);
+
+		std::string tunedPoolFile;
+
+		if(config.get<std::string>("message_pool_tuned_file", tunedPoolFile)) {
+			float headroom = 0.25f;
+			config.get<float>("message_pool_headroom", headroom);
+
+			if(pool.writeTunedSizes(tunedPoolFile, headroom)) {
+				std::cout << "[EvolvedPlus] tuned message pool written to " << tunedPoolFile << std::endl;
+			}
+		}
+
+#ifdef PROFILE_COMPONENTS
+		Profiling::CComponentProfiler::getInstance().writeRunReport(std::cout);
+#endif
+
+#ifdef TRACK_ALLOCATIONS
+		Profiling::CAllocationTracker::report(std::cout);
+#endif
+
+#ifdef TRACE_FRAMES
+		// write every recorded span, so frames can be inspected on a timeline
+		std::string traceFile = "Trace_EvolvedPlus.json";
+		config.get<std::string>("trace_file", traceFile);
+
+		Profiling::CTracer &tracer = Profiling::CTracer::getInstance();
+		tracer.write(traceFile);
+		std::cout << "[EvolvedPlus] trace written to " << traceFile << " ("
+		          << tracer.getDroppedEventCount() << " events dropped)" << std::endl;
+#endif
+	}
+
 	void CApplication::release() {
 		if(_instance) {
 			delete _instance;
@@ -1,14 +1,24 @@
 #include "Component.h"
+
+#include <cassert>
+
 #include "EvolvedPlus/Entity/EntityProperties.h"
 #include "EvolvedPlus/Messages/Message.h"
+#include "EvolvedPlus/Profiling/ComponentProfiler.h"
 #include "Application/Macros.h"
 
 namespace EvolvedPlus {
 
-	IComponent::IComponent(unsigned int priority, float updateFrequency) :
-		_entity(CEntityID::UNASSIGNED), _priority(priority), _updateFrequency(updateFrequency),
-		_currentUploadFrequency(0.0f) {
+	unsigned int IComponent::_typeCount = 0;
 
+	IComponent::IComponent(unsigned int priority, float updateFrequency, float slowestUpdateFrequency) :
+		_entity(CEntityID::UNASSIGNED), _priority(priority), _updateFrequency(updateFrequency),
+		_slowestUpdateFrequency(slowestUpdateFrequency == 0.0f ? updateFrequency : slowestUpdateFrequency),
+		_currentUploadFrequency(0.0f), _schedulePhase(0), _schedulePosition(0),
+		_batchPosition(0), _budgetTime(0.0) {
+		assert((_slowestUpdateFrequency == _updateFrequency ||
+		        (_updateFrequency > 0.0f && _slowestUpdateFrequency > _updateFrequency)) &&
+		       "Only components with an update frequency can be slowed down, and only to a slower one.");
 	}
 
 	IComponent::~IComponent() {
@@ -35,10 +45,16 @@ namespace EvolvedPlus {
 	}
 
 	void IComponent::doTick(float secs) {
+		PROFILE_COMPONENT_SECTION(this, DO_TICK);
+
 		// based on our update frequency, do we have to tick yet?
 		if(_updateFrequency == 0.0f) {
 			processMessages();
-			tick(secs);
+
+			{
+				PROFILE_COMPONENT_SECTION(this, TICK);
+				tick(secs);
+			}
 		} else if(_updateFrequency > 0.0f) {
 			_currentUploadFrequency += secs;
 
@@ -46,6 +62,7 @@ namespace EvolvedPlus {
 				processMessages();
 
 				while(_currentUploadFrequency >= _updateFrequency) {
+					PROFILE_COMPONENT_SECTION(this, TICK);
 					tick(_updateFrequency);
 					_currentUploadFrequency -= _updateFrequency;
 				}
@@ -53,7 +70,20 @@ namespace EvolvedPlus {
 		}
 	}
 
+	void IComponent::doDueTick(float secs, unsigned int times) {
+		PROFILE_COMPONENT_SECTION(this, DO_TICK);
+
+		processMessages();
+
+		for(unsigned int i = 0; i < times; ++i) {
+			PROFILE_COMPONENT_SECTION(this, TICK);
+			tick(secs);
+		}
+	}
+
 	void IComponent::processMessages() {
+		PROFILE_COMPONENT_SECTION(this, PROCESS_MESSAGES);
+
 		FOR_IT_CONST(TMessages, it, _messages) {
 			// process the message and release a reference from it
 			process(*it);
@@ -93,4 +123,20 @@ namespace EvolvedPlus {
 	unsigned int IComponent::getPriority() const {
 		return _priority;
 	}
+
+	float IComponent::getUpdateFrequency() const {
+		return _updateFrequency;
+	}
+
+	float IComponent::getSlowestUpdateFrequency() const {
+		return _slowestUpdateFrequency;
+	}
+
+	unsigned int IComponent::nextTypeID() {
+		return _typeCount++;
+	}
+
+	unsigned int IComponent::getTypeCount() {
+		return _typeCount;
+	}
 }
\ No newline at end of file
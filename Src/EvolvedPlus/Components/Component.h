@@ -3,8 +3,10 @@
 
 #include <string>
 #include <vector>
+#include <new>
 
 #include "ComponentFactory.h"
+#include "ComponentStorage.h"
 #include "EvolvedPlus/Entity/EntityID.h"
 #include "EvolvedPlus/Entity/EntityProperties.h"
 #include "EvolvedPlus/Messages/WishList.h"
@@ -15,6 +17,7 @@ namespace EvolvedPlus {
 	Forward declarations.
 	*/
 	class CLevel;
+	class CTickScheduler;
 
 	namespace Messages {
 		class CMessage;
@@ -31,6 +34,16 @@ namespace EvolvedPlus {
 	*/
 	class IComponent {
 	private:
+		/**
+		The scheduler of the level keeps track of where components are within it.
+		*/
+		friend class CTickScheduler;
+
+		/**
+		The level keeps track of when components it defers under a frame budget were last ticked.
+		*/
+		friend class CLevel;
+
 		/**
 		Alias for our list of messages to be processed.
 		*/
@@ -59,11 +72,45 @@ namespace EvolvedPlus {
 		*/
 		float _updateFrequency;
 
+		/**
+		Slowest update frequency this component can still work with, which its level falls
+		back to under load. It's the same as _updateFrequency when it can't be slowed down.
+		*/
+		float _slowestUpdateFrequency;
+
 		/**
 		Currently elapsed frequency.
 		*/
 		float _currentUploadFrequency;
 
+		/**
+		Phase of the group of its update frequency this component is in, in the scheduler of
+		its level, while it's scheduled.
+		*/
+		unsigned int _schedulePhase;
+
+		/**
+		Where this component is within its phase in the scheduler of its level, while it's scheduled.
+		*/
+		unsigned int _schedulePosition;
+
+		/**
+		Where this component is within its group of components of the same class in its level,
+		or among the ones deferred under a frame budget, while it's ticked every frame.
+		*/
+		unsigned int _batchPosition;
+
+		/**
+		Time of its level when this component was last ticked, in seconds, while the level has
+		a frame budget and this component can be deferred.
+		*/
+		double _budgetTime;
+
+		/**
+		How many component classes have been given a type ID so far.
+		*/
+		static unsigned int _typeCount;
+
 		/**
 		Processes messages delivered to this component.
 		*/
@@ -82,10 +129,38 @@ namespace EvolvedPlus {
 		virtual void process(Messages::CMessage *message);
 
 	public:
+		/**
+		What a component class does every frame, as declared through DECLARE_COMPONENT_TRAITS.
+		*/
+		enum {
+			/**
+			It does nothing every frame, it just holds data.
+			*/
+			TRAIT_NONE = 0,
+
+			/**
+			It overrides tick.
+			*/
+			TRAIT_TICKS = 1 << 0,
+
+			/**
+			It overrides process, so it's interested in some messages.
+			*/
+			TRAIT_PROCESSES_MESSAGES = 1 << 1,
+
+			/**
+			Every trait, which is what components declared through DECLARE_COMPONENT have.
+			*/
+			TRAIT_ALL = TRAIT_TICKS | TRAIT_PROCESSES_MESSAGES
+		};
+
 		/**
 		Base constructor. Represents the first part of component's instantiation.
+		Components with an update frequency can also give the slowest one they can still work
+		with (like TIMES_PER_SECOND(10) for a component updated TIMES_PER_SECOND(20)), so their
+		level can slow them down under load. 0 means they can't be slowed down.
 		*/
-		IComponent(unsigned int priority = 0, float updateFrequency = 0.0f);
+		IComponent(unsigned int priority = 0, float updateFrequency = 0.0f, float slowestUpdateFrequency = 0.0f);
 
 		/**
 		Base destructor, virtual as this is expected to be inherited.
@@ -114,6 +189,15 @@ namespace EvolvedPlus {
 		*/
 		void doTick(float secs);
 
+		/**
+		Called by the scheduler of the level when this component is due, this method will
+		process queued messages and delegate to tick as many times as given, without looking
+		at the update frequency.
+
+		@see CTickScheduler
+		*/
+		void doDueTick(float secs, unsigned int times);
+
 		/**
 		To be overriden by child components, it's called before doTick finishes.
 
@@ -148,10 +232,46 @@ namespace EvolvedPlus {
 		*/
 		virtual const std::string &getName() const = 0;
 
+		/**
+		Gets the type ID of this component, a dense number which identifies its class.
+		It's the same number for all instances of the same class.
+		*/
+		virtual unsigned int getTypeID() const = 0;
+
+		/**
+		Gets what this component does every frame, as a combination of TRAIT_ values.
+		It's the same for all instances of the same class. Levels never tick components
+		which don't tick nor process messages, and never suscribe components which don't
+		process messages.
+		*/
+		virtual unsigned int getTraits() const = 0;
+
+		/**
+		Hands out the type ID of a new component class. Type IDs start at 0 and have no holes,
+		so they can be used as an index.
+		*/
+		static unsigned int nextTypeID();
+
+		/**
+		Gets how many component classes have been given a type ID.
+		*/
+		static unsigned int getTypeCount();
+
 		/**
 		Gets the priority of this component.
 		*/
 		unsigned int getPriority() const;
+
+		/**
+		Gets the update frequency of this component.
+		*/
+		float getUpdateFrequency() const;
+
+		/**
+		Gets the slowest update frequency of this component, which is the same as its update
+		frequency if it can't be slowed down.
+		*/
+		float getSlowestUpdateFrequency() const;
 	};
 
 	/**
@@ -178,8 +298,16 @@ namespace EvolvedPlus {
 	class that will be defined.
 	Must be used within the component class' declaration, preferable as the first entry.
 	The only parameter of the macro isn't used, but exists to provide an uniform structure.
+	Components declared through it are expected to tick and process messages.
 	*/
-#define DECLARE_COMPONENT(ComponentClass) \
+#define DECLARE_COMPONENT(ComponentClass) DECLARE_COMPONENT_TRAITS(ComponentClass, IComponent::TRAIT_ALL)
+
+	/**
+	Same as DECLARE_COMPONENT, but it also declares what the component does every frame, as
+	a combination of IComponent::TRAIT_ values. Components which only hold data should use
+	IComponent::TRAIT_NONE, so they don't cost anything while their level is ticked.
+	*/
+#define DECLARE_COMPONENT_TRAITS(ComponentClass, traits) \
 public: \
 	/** \
 	Creates an instance of the component in which this is defined. \
@@ -187,6 +315,11 @@ public: \
 	static IComponent *create(); \
 	\
 	/** \
+	Creates an instance of the component in which this is defined, in the given memory. \
+	*/ \
+	static IComponent *createAt(void *memory); \
+	\
+	/** \
 	Registers the component into the component factory. \
 	*/ \
 	static bool registerComponent(); \
@@ -199,7 +332,38 @@ public: \
 	/** \
 	Overrides parent's getName(). \
 	*/ \
-	const std::string &getName() const;
+	const std::string &getName() const; \
+	\
+	/** \
+	Dense number which identifies this component class, used to look components up by type. \
+	*/ \
+	static unsigned int componentTypeID; \
+	\
+	/** \
+	Overrides parent's getTypeID(). \
+	*/ \
+	unsigned int getTypeID() const; \
+	\
+	/** \
+	What this component class does every frame. \
+	*/ \
+	static const unsigned int componentTraits = traits; \
+	\
+	/** \
+	Overrides parent's getTraits(). \
+	*/ \
+	unsigned int getTraits() const; \
+	\
+	/** \
+	Builds instances of this component side by side with the rest of its class. \
+	@see CComponentStorage \
+	*/ \
+	static void *operator new(std::size_t size); \
+	\
+	/** \
+	Gives back the room of an instance of this component to the rest of its class. \
+	*/ \
+	static void operator delete(void *memory);
 
 	/**
 	This macro defines some static methods that are part of every component, declared by
@@ -211,8 +375,13 @@ public: \
 		return new ComponentClass(); \
 	} \
 	\
+	IComponent *ComponentClass::createAt(void *memory) { \
+		return ::new (memory) ComponentClass(); \
+	} \
+	\
 	bool ComponentClass::registerComponent() { \
-		CComponentFactory::getInstance().add(#ComponentClass, ComponentClass::create); \
+		CComponentFactory::getInstance().add(#ComponentClass, ComponentClass::create, ComponentClass::createAt, \
+		                                     sizeof(ComponentClass)); \
 		/* just return true always because we need to return something for REGISTER_COMPONENT macro to work correctly */ \
 		return true; \
 	} \
@@ -221,6 +390,24 @@ public: \
 	\
 	const std::string &ComponentClass::getName() const { \
 		return ComponentClass::componentName; \
+	} \
+	\
+	unsigned int ComponentClass::componentTypeID = IComponent::nextTypeID(); \
+	\
+	unsigned int ComponentClass::getTypeID() const { \
+		return ComponentClass::componentTypeID; \
+	} \
+	\
+	unsigned int ComponentClass::getTraits() const { \
+		return ComponentClass::componentTraits; \
+	} \
+	\
+	void *ComponentClass::operator new(std::size_t size) { \
+		return CComponentStorage::allocate(ComponentClass::componentTypeID, size); \
+	} \
+	\
+	void ComponentClass::operator delete(void *memory) { \
+		CComponentStorage::deallocate(memory); \
 	}
 
 	/**
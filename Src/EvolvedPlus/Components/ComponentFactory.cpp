@@ -44,12 +44,16 @@ namespace EvolvedPlus {
 		return *_instance;
 	}
 
-	void CComponentFactory::add(const std::string &name, ComponentInstantiator instantiator) {
+	void CComponentFactory::add(const std::string &name, ComponentInstantiator instantiator,
+	                            ComponentPlacementInstantiator placementInstantiator, std::size_t size) {
 		/**
 		Each time we include a compilation unit of a component, it will be registered into this factory.
 		We'll just override its value since it's cheaper than looking for it and then doing nothing.
 		*/
-		_components[name] = instantiator;
+		CComponentClass &componentClass = _components[name];
+		componentClass.instantiator = instantiator;
+		componentClass.placementInstantiator = placementInstantiator;
+		componentClass.size = size;
 	}
 
 	IComponent *CComponentFactory::build(const std::string &name) const {
@@ -57,7 +61,19 @@ namespace EvolvedPlus {
 		assert(_components.count(name) != 0 && "Trying to build an unregistered component.");
 
 		// build the component and return it (we know it exists or else the assert would've failed)
-		return _components.find(name)->second();
+		return _components.find(name)->second.instantiator();
+	}
+
+	IComponent *CComponentFactory::buildAt(const std::string &name, void *memory) const {
+		assert(_components.count(name) != 0 && "Trying to build an unregistered component.");
+
+		return _components.find(name)->second.placementInstantiator(memory);
+	}
+
+	std::size_t CComponentFactory::getSize(const std::string &name) const {
+		assert(_components.count(name) != 0 && "Trying to get the size of an unregistered component.");
+
+		return _components.find(name)->second.size;
 	}
 
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <map>
+#include <cstddef>
 
 namespace EvolvedPlus {
 
@@ -57,10 +58,35 @@ namespace EvolvedPlus {
 		*/
 		typedef IComponent *(*ComponentInstantiator)();
 
+		/**
+		Alias for a function pointer which creates a component in the given memory.
+		*/
+		typedef IComponent *(*ComponentPlacementInstantiator)(void *memory);
+
+		/**
+		Everything we know about how to build a component class.
+		*/
+		struct CComponentClass {
+			/**
+			Function which creates a component of this class.
+			*/
+			ComponentInstantiator instantiator;
+
+			/**
+			Function which creates a component of this class in the given memory.
+			*/
+			ComponentPlacementInstantiator placementInstantiator;
+
+			/**
+			Size of a component of this class, in bytes.
+			*/
+			std::size_t size;
+		};
+
 		/**
 		Alias for our structure to store component constructors.
 		*/
-		typedef std::map<std::string, ComponentInstantiator> TComponents;
+		typedef std::map<std::string, CComponentClass> TComponents;
 
 		/**
 		Structure to store component names and functions to create each one of them.
@@ -89,12 +115,24 @@ namespace EvolvedPlus {
 		/**
 		Adds a component to the internal structure.
 		*/
-		void add(const std::string &name, ComponentInstantiator instantiator);
+		void add(const std::string &name, ComponentInstantiator instantiator,
+		         ComponentPlacementInstantiator placementInstantiator, std::size_t size);
 
 		/**
 		Creates a component given a name, which will just build it but won't initialize it.
 		*/
 		IComponent *build(const std::string &entityType) const;
+
+		/**
+		Creates a component given a name in the given memory, which must be big enough
+		and come from the component storage, so the component can be deleted as usual.
+		*/
+		IComponent *buildAt(const std::string &name, void *memory) const;
+
+		/**
+		Gets the size of a component given its name, in bytes.
+		*/
+		std::size_t getSize(const std::string &name) const;
 	};
 
 }
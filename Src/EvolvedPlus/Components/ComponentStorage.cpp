@@ -0,0 +1,198 @@
+#include "ComponentStorage.h"
+
+#include <cassert>
+#include <new>
+
+#include "Application/Macros.h"
+
+namespace EvolvedPlus {
+
+	/**
+	Every slot is padded to a multiple of this many bytes, so slots are as aligned as the
+	chunks they're in. Chunks come from the global operator new, which only guarantees the
+	alignment of fundamental types (8 bytes on Win32, 16 on x64), so components can't hold
+	types which need more than that (i.e. SSE vectors declared with __declspec(align(16))).
+	*/
+#define COMPONENT_SLOT_ALIGNMENT 16
+
+	/**
+	Rounds a size up to the alignment of slots.
+	*/
+#define COMPONENT_ALIGN(size) (((size) + COMPONENT_SLOT_ALIGNMENT - 1) / COMPONENT_SLOT_ALIGNMENT * COMPONENT_SLOT_ALIGNMENT)
+
+	/**
+	Every row begins with this header.
+	*/
+	struct CComponentRowHeader {
+		/**
+		Next free row, while this one is free.
+		*/
+		void *nextFree;
+
+		/**
+		How many slots of this row are in use.
+		*/
+		unsigned int aliveCount;
+	};
+
+	CComponentLayout::CComponentLayout(const std::vector<std::size_t> &slotSizes) :
+		_rowSize(COMPONENT_ALIGN(sizeof(CComponentRowHeader))), _lastChunkUsage(COMPONENT_CHUNK_SIZE),
+		_freeRows(NULL), _aliveCount(0) {
+		FOR_IT_CONST(std::vector<std::size_t>, it, slotSizes) {
+			_offsets.push_back(_rowSize);
+			_rowSize += COMPONENT_ALIGN(*it);
+		}
+	}
+
+	CComponentLayout::~CComponentLayout() {
+		FOR_IT_CONST(TChunks, it, _chunks) {
+			::operator delete(*it);
+		}
+
+		_chunks.clear();
+	}
+
+	unsigned int CComponentLayout::getSlotCount() const {
+		return _offsets.size();
+	}
+
+	unsigned int CComponentLayout::getAliveCount() const {
+		return _aliveCount;
+	}
+
+	unsigned int CComponentLayout::getChunkCount() const {
+		return _chunks.size();
+	}
+
+	CComponentStorage::TLayouts CComponentStorage::_classLayouts;
+	CComponentStorage::TLayouts CComponentStorage::_layouts;
+	CComponentStorage::TChunkLayouts CComponentStorage::_chunkLayouts;
+
+	CComponentLayout *CComponentStorage::createLayout(const std::vector<std::size_t> &slotSizes) {
+		CComponentLayout *layout = new CComponentLayout(slotSizes);
+		_layouts.push_back(layout);
+
+		return layout;
+	}
+
+	void *CComponentStorage::allocateRow(CComponentLayout &layout) {
+		void *row;
+
+		// reuse the last released row, if any
+		if(layout._freeRows) {
+			row = layout._freeRows;
+			layout._freeRows = static_cast<CComponentRowHeader *>(row)->nextFree;
+		} else {
+			// otherwise, take the next row of the last chunk, or a brand new chunk
+			if(layout._lastChunkUsage == COMPONENT_CHUNK_SIZE) {
+				char *chunk = static_cast<char *>(::operator new(layout._rowSize * COMPONENT_CHUNK_SIZE));
+				layout._chunks.push_back(chunk);
+				_chunkLayouts[chunk] = &layout;
+				layout._lastChunkUsage = 0;
+			}
+
+			row = layout._chunks.back() + layout._rowSize * layout._lastChunkUsage++;
+		}
+
+		CComponentRowHeader *header = static_cast<CComponentRowHeader *>(row);
+		header->nextFree = NULL;
+		header->aliveCount = layout._offsets.size();
+		layout._aliveCount += layout._offsets.size();
+
+		return row;
+	}
+
+	void *CComponentStorage::getSlot(const CComponentLayout &layout, void *row, unsigned int slot) {
+		assert(slot < layout._offsets.size() && "The layout doesn't have that many slots.");
+
+		return static_cast<char *>(row) + layout._offsets[slot];
+	}
+
+	void *CComponentStorage::allocate(unsigned int type, std::size_t size) {
+		if(type >= _classLayouts.size()) {
+			_classLayouts.resize(type + 1, NULL);
+		}
+
+		// the first allocation decides the size of the slots
+		if(!_classLayouts[type]) {
+			_classLayouts[type] = createLayout(std::vector<std::size_t>(1, size));
+		}
+
+		CComponentLayout &layout = *_classLayouts[type];
+
+		// subclasses which don't declare themselves share the operator new of their parent, but
+		// they might not fit in its slots, so they're built on their own
+		if(COMPONENT_ALIGN(size) + layout._offsets[0] > layout._rowSize) {
+			return ::operator new(size);
+		}
+
+		return getSlot(layout, allocateRow(layout), 0);
+	}
+
+	void CComponentStorage::deallocate(void *memory) {
+		if(memory == NULL) {
+			return;
+		}
+
+		// find the chunk the component is in, which is the last one beginning before it
+		TChunkLayouts::const_iterator it = _chunkLayouts.upper_bound(static_cast<const char *>(memory));
+
+		// components which aren't within any chunk were built on their own
+		if(it == _chunkLayouts.begin()) {
+			::operator delete(memory);
+			return;
+		}
+
+		--it;
+
+		CComponentLayout &layout = *it->second;
+		std::size_t offset = static_cast<const char *>(memory) - it->first;
+
+		if(offset >= layout._rowSize * COMPONENT_CHUNK_SIZE) {
+			::operator delete(memory);
+			return;
+		}
+
+		CComponentRowHeader *header = reinterpret_cast<CComponentRowHeader *>(const_cast<char *>(it->first) +
+		                                                                      offset / layout._rowSize * layout._rowSize);
+		assert(header->aliveCount > 0 && "Releasing a component twice.");
+		layout._aliveCount--;
+
+		// once every slot is free, the row becomes the head of the free list
+		if(--header->aliveCount == 0) {
+			header->nextFree = layout._freeRows;
+			layout._freeRows = header;
+		}
+	}
+
+	const CComponentLayout *CComponentStorage::getClassLayout(unsigned int type) {
+		return type < _classLayouts.size() ? _classLayouts[type] : NULL;
+	}
+
+	void CComponentStorage::release() {
+		TLayouts layouts;
+
+		FOR_IT_CONST(TLayouts, it, _layouts) {
+			// components which are still alive would be left dangling
+			if((*it)->_aliveCount > 0) {
+				layouts.push_back(*it);
+				continue;
+			}
+
+			FOR_IT_CONST(CComponentLayout::TChunks, itChunk, (*it)->_chunks) {
+				_chunkLayouts.erase(*itChunk);
+			}
+
+			FOR_IT(TLayouts, itClass, _classLayouts) {
+				if(*itClass == *it) {
+					*itClass = NULL;
+				}
+			}
+
+			delete *it;
+		}
+
+		_layouts.swap(layouts);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#ifndef EvolvedPlus_ComponentStorage_H
+#define EvolvedPlus_ComponentStorage_H
+
+#include <cstddef>
+#include <vector>
+#include <map>
+
+namespace EvolvedPlus {
+
+	/**
+	How many rows are stored side by side in each chunk.
+	*/
+#define COMPONENT_CHUNK_SIZE 256
+
+	/**
+	Describes how components are laid out in memory: every row holds a fixed set of
+	components side by side (one slot each), and rows are stored side by side in chunks
+	of COMPONENT_CHUNK_SIZE rows.
+	Every component class has a layout of its own, with a single slot, and so does every
+	set of components an entity can be made of (which is what archetypes boil down to).
+
+	Slots of a row are given back one by one as components are destroyed, and once every
+	slot in a row is free the row is kept in a free list (stored within the rows
+	themselves) to be reused.
+	*/
+	class CComponentLayout {
+	private:
+		/**
+		The storage is the only one which manages layouts.
+		*/
+		friend class CComponentStorage;
+
+		/**
+		Alias for the list of chunks of a layout.
+		*/
+		typedef std::vector<char *> TChunks;
+
+		/**
+		Offset of every slot within a row, in bytes.
+		*/
+		std::vector<std::size_t> _offsets;
+
+		/**
+		Size of every row, in bytes, including its header.
+		*/
+		std::size_t _rowSize;
+
+		/**
+		Chunks in which rows are stored.
+		*/
+		TChunks _chunks;
+
+		/**
+		How many rows of the last chunk have been handed out at least once.
+		*/
+		unsigned int _lastChunkUsage;
+
+		/**
+		First row which was released and can be reused, if any.
+		*/
+		void *_freeRows;
+
+		/**
+		How many components are alive.
+		*/
+		unsigned int _aliveCount;
+
+		/**
+		Basic constructor, given the size of every slot.
+		*/
+		CComponentLayout(const std::vector<std::size_t> &slotSizes);
+
+		/**
+		Basic destructor, frees every chunk.
+		*/
+		~CComponentLayout();
+
+	public:
+		/**
+		Gets how many slots every row has.
+		*/
+		unsigned int getSlotCount() const;
+
+		/**
+		Gets how many components are alive.
+		*/
+		unsigned int getAliveCount() const;
+
+		/**
+		Gets how many chunks have been allocated.
+		*/
+		unsigned int getChunkCount() const;
+	};
+
+	/**
+	Components are polymorphic, so they're built one by one through the component factory.
+	Left to the global operator new, they would end up scattered across the heap, mixed
+	with everything else.
+	Instead, they're stored in chunks described by layouts. Component classes get this for
+	free through DECLARE_COMPONENT, which gives them an operator new and an operator delete
+	routed here, so a component built on its own is stored side by side with the rest of
+	its class. The entity factory goes a step further and builds every component of an
+	entity into a single row of the layout of its set of components, so entities with the
+	same components have all of their component data side by side.
+
+	Its state is just a list of layouts and where their chunks are, so it's a class with
+	static methods and data, like the allocation tracker.
+	*/
+	class CComponentStorage {
+	private:
+		/**
+		Alias for a list of layouts.
+		*/
+		typedef std::vector<CComponentLayout *> TLayouts;
+
+		/**
+		Layout of every component class, indexed by type ID (NULL until it's needed).
+		*/
+		static TLayouts _classLayouts;
+
+		/**
+		Layouts created for sets of components.
+		*/
+		static TLayouts _layouts;
+
+		/**
+		Alias for the chunks of every layout, by the address they begin at.
+		*/
+		typedef std::map<const char *, CComponentLayout *> TChunkLayouts;
+
+		/**
+		Layout of every chunk, by the address it begins at, so a component can be given
+		back knowing nothing but its address.
+		*/
+		static TChunkLayouts _chunkLayouts;
+
+	public:
+		/**
+		Creates a layout whose rows hold slots of the given sizes, in the same order.
+		It's owned by the storage.
+		*/
+		static CComponentLayout *createLayout(const std::vector<std::size_t> &slotSizes);
+
+		/**
+		Gets a row of a layout, in which every slot is considered in use.
+		Every slot must be filled with a component afterwards.
+		*/
+		static void *allocateRow(CComponentLayout &layout);
+
+		/**
+		Gets where a slot of a row begins.
+		*/
+		static void *getSlot(const CComponentLayout &layout, void *row, unsigned int slot);
+
+		/**
+		Gets room for a component of the given type ID, in the layout of its class.
+		Slots are as big as the first instance of the type, so bigger ones (subclasses which
+		don't declare themselves) are built on their own through the global operator new.
+		*/
+		static void *allocate(unsigned int type, std::size_t size);
+
+		/**
+		Gives back the room of a component once it's been destroyed, wherever it was, even
+		if it was built on its own.
+		*/
+		static void deallocate(void *memory);
+
+		/**
+		Gets the layout of a component class, if it has been needed yet.
+		*/
+		static const CComponentLayout *getClassLayout(unsigned int type);
+
+		/**
+		Frees every layout with no components alive.
+		*/
+		static void release();
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <fstream>
 
+#include "EvolvedPlus/Profiling/StartupProfiler.h"
+
 namespace EvolvedPlus {
 
 #define CONFIG_FILE "Configuration.txt"
@@ -45,6 +47,8 @@ namespace EvolvedPlus {
 	}
 
 	void CConfig::parseConfigFile(const std::string &filePath) {
+		Profiling::CStartupPhaseScope phase("CConfig::parseConfigFile");
+
 		// does the file exist?
 		std::ifstream in(filePath);
 		assert(in && "Config file couldn't be opened.");
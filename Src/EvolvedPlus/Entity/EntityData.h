@@ -17,23 +17,21 @@ namespace EvolvedPlus {
 	/**
 	In this approach, entities are just an identifier and some data associated
 	to it instead of being a full abstraction with behavior.
-	This data structure packs that data into a more usable concept.
+	This data structure packs the part of that data which is needed every frame,
+	while the rest of it lives in CEntityColdData. Levels keep both apart, so
+	ticking entities only goes through what it really touches.
 	*/
 	struct CEntityData {
 		/**
-		Entity's name.
-		*/
-		std::string name;
-
-		/**
-		Entity's type.
+		Is this entity active?
 		*/
-		std::string type;
+		bool active;
 
 		/**
-		Is this entity active?
+		Where this entity is within the list of active entities of the level, while it's active.
+		It's kept up to date by the level.
 		*/
-		bool active;
+		unsigned int activePosition;
 
 		/**
 		Entity's components, sorted by their priority.
@@ -41,6 +39,55 @@ namespace EvolvedPlus {
 		*/
 		std::vector<IComponent *> components;
 
+		/**
+		Active components of this entity which are ticked every frame, sorted by their priority.
+		Components with an update frequency are ticked by the scheduler of the level instead,
+		and components which do nothing every frame aren't ticked at all.
+		It's kept up to date by the level.
+		*/
+		std::vector<IComponent *> tickedComponents;
+
+		/**
+		Active components for this entity, indexed by the type ID of their class (NULL for
+		classes the entity has no active component of). It's as long as the biggest type ID
+		among them, plus one, and it's kept up to date by the level.
+		*/
+		std::vector<IComponent *> componentsByType;
+
+		/**
+		Archetype of the level this entity belongs to, given its active components.
+		It's kept up to date by the level.
+		*/
+		unsigned int archetype;
+
+		/**
+		Where this entity is within its archetype.
+		*/
+		unsigned int archetypePosition;
+
+		/**
+		Default constructor, the entity starts inactive.
+		*/
+		CEntityData() : active(false), activePosition(0), archetype(0), archetypePosition(0) {
+
+		}
+	};
+
+	/**
+	Data associated to an entity which isn't needed every frame: it's used while
+	loading the level, by tools, or when components are enabled or disabled.
+	*/
+	struct CEntityColdData {
+		/**
+		Entity's name.
+		*/
+		std::string name;
+
+		/**
+		Entity's type.
+		*/
+		std::string type;
+
 		/**
 		Inactive components for this entity.
 		*/
@@ -48,6 +95,7 @@ namespace EvolvedPlus {
 
 		/**
 		Data defined in the level for this entity.
+		It's released once the entity is spawned when RELEASE_ENTITY_PROPERTIES is defined.
 		*/
 		CEntityProperties data;
 	};
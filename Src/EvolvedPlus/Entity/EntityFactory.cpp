@@ -6,9 +6,11 @@
 #include "EntityID.h"
 #include "EvolvedPlus/Components/Component.h"
 #include "EvolvedPlus/Components/ComponentFactory.h"
+#include "EvolvedPlus/Components/ComponentStorage.h"
 #include "EvolvedPlus/Level/Level.h"
 #include "EvolvedPlus/Level/LevelEntry.h"
 #include "EvolvedPlus/Config/Config.h"
+#include "EvolvedPlus/Profiling/StartupProfiler.h"
 #include "Application/Macros.h"
 
 namespace EvolvedPlus {
@@ -20,7 +22,7 @@ namespace EvolvedPlus {
 	}
 
 	CEntityFactory::~CEntityFactory() {
-
+		_layouts.clear();
 	}
 
 	CEntityFactory::CEntityFactory(const CEntityFactory &factory) {
@@ -56,10 +58,14 @@ namespace EvolvedPlus {
 		// create the entity data, which won't have any component or anything yet
 		CEntityData entity;
 
-		// build its components
+		// build its components, side by side in a single row of the layout of its set of components
 		CEntityProperties::TComponentNames componentNames = properties.getComponentNames();
+		CComponentLayout &layout = getLayout(componentNames);
+		void *row = CComponentStorage::allocateRow(layout);
+		unsigned int slot = 0;
+
 		FOR_IT_CONST(CEntityProperties::TComponentNames, it, componentNames) {
-			IComponent *component = CComponentFactory::getInstance().build(*it);
+			IComponent *component = CComponentFactory::getInstance().buildAt(*it, CComponentStorage::getSlot(layout, row, slot++));
 			entity.components.push_back(component);
 
 			component->setEntity(id);
@@ -73,6 +79,8 @@ namespace EvolvedPlus {
 	}
 
 	void CEntityFactory::parseArchetypes() {
+		Profiling::CStartupPhaseScope phase("CEntityFactory::parseArchetypes");
+
 		std::string fileName;
 
 		if(!CConfig::getInstance().get<std::string>("archetypes_evolved_plus", fileName)) {
@@ -107,6 +115,30 @@ namespace EvolvedPlus {
 				properties->setParent(getArchetype(properties->_data.archetype));
 			}
 		}
+
+		// and prepare the component layout of every archetype, now that we know their components
+		FOR_IT_CONST(TArchetypes, it, _archetypes) {
+			getLayout(it->second.getComponentNames());
+		}
+	}
+
+	CComponentLayout &CEntityFactory::getLayout(const CEntityProperties::TComponentNames &componentNames) const {
+		TLayouts::const_iterator it = _layouts.find(componentNames);
+
+		if(it != _layouts.end()) {
+			return *it->second;
+		}
+
+		std::vector<std::size_t> slotSizes;
+
+		FOR_IT_CONST(CEntityProperties::TComponentNames, itName, componentNames) {
+			slotSizes.push_back(CComponentFactory::getInstance().getSize(*itName));
+		}
+
+		CComponentLayout *layout = CComponentStorage::createLayout(slotSizes);
+		_layouts[componentNames] = layout;
+
+		return *layout;
 	}
 
 	CEntityProperties *CEntityFactory::getArchetype(const std::string &name) {
@@ -11,6 +11,11 @@
 
 namespace EvolvedPlus {
 
+	/**
+	Forward declarations.
+	*/
+	class CComponentLayout;
+
 	/**
 	The task of creating and destroying entities is delegated to this factory.
 	Entities have two important concepts: they have a name and they have components.
@@ -25,6 +30,11 @@ namespace EvolvedPlus {
 	Whenever a level is built, entries might have references to these archetypes and the
 	factory will be asked to provide references to those archetypes.
 
+	Entities with the same set of components (as every entity of an archetype, unless the
+	level adds some more) are built into rows of the same component layout, so all of
+	their component data lives side by side in fixed-size chunks. Layouts of archetypes
+	are prepared when parsing them, and any other set gets one the first time it's built.
+
 	It's implemented as a one-step initialization singleton, which is protected against
 	accidental or intentional copies.
 	*/
@@ -68,6 +78,22 @@ namespace EvolvedPlus {
 		*/
 		TArchetypes _archetypes;
 
+		/**
+		Alias to store the component layout of every set of components.
+		*/
+		typedef std::map<CEntityProperties::TComponentNames, CComponentLayout *> TLayouts;
+
+		/**
+		Component layout of every set of components built so far, owned by the component storage.
+		*/
+		mutable TLayouts _layouts;
+
+		/**
+		Gets the component layout of a set of components, creating it if needed.
+		Slots are in the same order as the names in the set.
+		*/
+		CComponentLayout &getLayout(const CEntityProperties::TComponentNames &componentNames) const;
+
 		/**
 		Parses archetype file and builds up the archetypes map.
 		*/
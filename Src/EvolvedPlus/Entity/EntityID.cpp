@@ -4,15 +4,39 @@
 
 namespace EvolvedPlus {
 
-	TEntityID CEntityID::_nextID = CEntityID::FIRST_ID;
+	std::vector<unsigned int> CEntityID::_generations;
+	std::deque<unsigned int> CEntityID::_freeIndices;
 
 	TEntityID CEntityID::nextID() {
-		TEntityID id = CEntityID::_nextID;
+		unsigned int index;
 
-		assert(id != CEntityID::LAST_ID && "No more entity IDs available");
+		if(!_freeIndices.empty()) {
+			index = _freeIndices.front();
+			_freeIndices.pop_front();
+		} else {
+			index = _generations.size();
 
-		_nextID++;
-		return id;
+			// the last index is never handed out, so no ID can be the same as UNASSIGNED
+			assert(index < CEntityID::INDEX_MASK && "No more entity IDs available");
+
+			_generations.push_back(0);
+		}
+
+		return (_generations[index] << CEntityID::INDEX_BITS) | index;
+	}
+
+	void CEntityID::releaseID(const TEntityID &id) {
+		assert(isAlive(id) && "Releasing an entity ID which isn't alive.");
+
+		unsigned int index = getIndex(id);
+		_generations[index] = (_generations[index] + 1) & CEntityID::GENERATION_MASK;
+		_freeIndices.push_back(index);
+	}
+
+	bool CEntityID::isAlive(const TEntityID &id) {
+		unsigned int index = getIndex(id);
+
+		return index < _generations.size() && _generations[index] == getGeneration(id);
 	}
 
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef EvolvedPlus_EntityID_H
 #define EvolvedPlus_EntityID_H
 
+#include <vector>
+#include <deque>
+
 namespace EvolvedPlus {
 
 	/**
@@ -9,16 +12,27 @@ namespace EvolvedPlus {
 	typedef unsigned int TEntityID;
 
 	/**
-	Entity ID's are generated incrementally and won't be recycled when entities are
-	destroyed. By calling its nextID() method we get the next available ID for an
-	entity, which is guaranteed to be unique as the same ID won't be returned again.
+	Entity ID's are generational handles: the lower bits are an index, and the upper bits
+	are the generation of that index. By calling its nextID() method we get the next
+	available ID for an entity. Once an entity is destroyed its ID must be released, so
+	its index can be recycled, but with the next generation. That way, anything indexed
+	by the index of an ID stays as small as the amount of entities alive, and an ID which
+	was released can be told apart from the new one using the same index.
+
+	Released indices are recycled in the same order they were released, so generations
+	take as long as possible to wrap around.
 	*/
 	class CEntityID {
 	private:
 		/**
-		Next available ID.
+		Current generation of every index handed out so far.
+		*/
+		static std::vector<unsigned int> _generations;
+
+		/**
+		Indices released and ready to be recycled, oldest first.
 		*/
-		static TEntityID _nextID;
+		static std::deque<unsigned int> _freeIndices;
 
 	public:
 		/**
@@ -27,13 +41,40 @@ namespace EvolvedPlus {
 		enum {
 			FIRST_ID = 0x00000000,
 			LAST_ID = 0xFFFFFFFE,
-			UNASSIGNED = 0xFFFFFFFF
+			UNASSIGNED = 0xFFFFFFFF,
+			INDEX_BITS = 22,
+			INDEX_MASK = (1 << INDEX_BITS) - 1,
+			GENERATION_MASK = (1 << (32 - INDEX_BITS)) - 1
 		};
 
 		/**
 		Gets the next available ID.
 		*/
 		static TEntityID nextID();
+
+		/**
+		Releases an ID of an entity which was destroyed, so its index can be recycled.
+		*/
+		static void releaseID(const TEntityID &id);
+
+		/**
+		Whether an ID was handed out and hasn't been released yet.
+		*/
+		static bool isAlive(const TEntityID &id);
+
+		/**
+		Gets the index of an ID, which is unique among entities alive at the same time.
+		*/
+		static unsigned int getIndex(const TEntityID &id) {
+			return id & INDEX_MASK;
+		}
+
+		/**
+		Gets the generation of an ID.
+		*/
+		static unsigned int getGeneration(const TEntityID &id) {
+			return id >> INDEX_BITS;
+		}
 	};
 
 }
@@ -0,0 +1,110 @@
+#include "Archetype.h"
+
+#include <cassert>
+
+#include "Application/Macros.h"
+
+namespace EvolvedPlus {
+
+	CArchetype::CArchetype(const TSignature &signature) : _signature(signature), _entityCount(0) {
+		for(unsigned int column = 0; column < _signature.size(); ++column) {
+			unsigned int type = _signature[column];
+
+			if(type >= _columns.size()) {
+				_columns.resize(type + 1, INVALID_COLUMN);
+			}
+
+			_columns[type] = column;
+		}
+	}
+
+	CArchetype::~CArchetype() {
+		FOR_IT_CONST(TChunks, it, _chunks) {
+			delete[] (*it)->components;
+			delete *it;
+		}
+
+		_chunks.clear();
+	}
+
+	const CArchetype::TSignature &CArchetype::getSignature() const {
+		return _signature;
+	}
+
+	unsigned int CArchetype::getColumn(unsigned int type) const {
+		return type < _columns.size() ? _columns[type] : INVALID_COLUMN;
+	}
+
+	bool CArchetype::hasType(unsigned int type) const {
+		return getColumn(type) != INVALID_COLUMN;
+	}
+
+	unsigned int CArchetype::add(const TEntityID &entity, const std::vector<IComponent *> &componentsByType) {
+		// chunks are kept once they're empty, so there's always room in the last one unless it's full
+		if(_entityCount == _chunks.size() * ARCHETYPE_CHUNK_SIZE) {
+			CArchetypeChunk *chunk = new CArchetypeChunk();
+			chunk->count = 0;
+			chunk->components = new IComponent *[_signature.size() * ARCHETYPE_CHUNK_SIZE];
+			_chunks.push_back(chunk);
+		}
+
+		unsigned int position = _entityCount++;
+		CArchetypeChunk &chunk = *_chunks[position / ARCHETYPE_CHUNK_SIZE];
+		unsigned int index = position % ARCHETYPE_CHUNK_SIZE;
+
+		chunk.entities[index] = entity;
+		chunk.count++;
+
+		for(unsigned int column = 0; column < _signature.size(); ++column) {
+			chunk.components[column * ARCHETYPE_CHUNK_SIZE + index] = componentsByType[_signature[column]];
+		}
+
+		return position;
+	}
+
+	TEntityID CArchetype::remove(unsigned int position) {
+		assert(position < _entityCount && "Removing an entity which isn't in the archetype.");
+
+		unsigned int last = --_entityCount;
+		CArchetypeChunk &lastChunk = *_chunks[last / ARCHETYPE_CHUNK_SIZE];
+		unsigned int lastIndex = last % ARCHETYPE_CHUNK_SIZE;
+		lastChunk.count--;
+
+		if(position == last) {
+			return CEntityID::UNASSIGNED;
+		}
+
+		// move the last entity into the hole, so chunks stay packed
+		CArchetypeChunk &chunk = *_chunks[position / ARCHETYPE_CHUNK_SIZE];
+		unsigned int index = position % ARCHETYPE_CHUNK_SIZE;
+
+		chunk.entities[index] = lastChunk.entities[lastIndex];
+
+		for(unsigned int column = 0; column < _signature.size(); ++column) {
+			chunk.components[column * ARCHETYPE_CHUNK_SIZE + index] = lastChunk.components[column * ARCHETYPE_CHUNK_SIZE + lastIndex];
+		}
+
+		return chunk.entities[index];
+	}
+
+	unsigned int CArchetype::getEntityCount() const {
+		return _entityCount;
+	}
+
+	unsigned int CArchetype::getChunkCount() const {
+		return _chunks.size();
+	}
+
+	const CArchetypeChunk &CArchetype::getChunk(unsigned int chunk) const {
+		assert(chunk < _chunks.size() && "The archetype doesn't have that many chunks.");
+
+		return *_chunks[chunk];
+	}
+
+	IComponent *const *CArchetype::getComponents(const CArchetypeChunk &chunk, unsigned int type) const {
+		assert(hasType(type) && "The component class isn't part of the archetype.");
+
+		return chunk.components + getColumn(type) * ARCHETYPE_CHUNK_SIZE;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef EvolvedPlus_Archetype_H
+#define EvolvedPlus_Archetype_H
+
+#include <vector>
+
+#include "EvolvedPlus/Entity/EntityID.h"
+
+namespace EvolvedPlus {
+
+	/**
+	Forward declarations.
+	*/
+	class IComponent;
+
+	/**
+	How many entities are stored side by side in each chunk of an archetype.
+	*/
+#define ARCHETYPE_CHUNK_SIZE 128
+
+	/**
+	Chunk of entities of an archetype. It keeps the identifier of every entity and, for
+	every component class in the archetype, a column with the component of every entity.
+	*/
+	struct CArchetypeChunk {
+		/**
+		How many entities are in this chunk.
+		*/
+		unsigned int count;
+
+		/**
+		Identifier of every entity in this chunk.
+		*/
+		TEntityID entities[ARCHETYPE_CHUNK_SIZE];
+
+		/**
+		Every column of components, one after the other, each ARCHETYPE_CHUNK_SIZE long.
+		*/
+		IComponent **components;
+	};
+
+	/**
+	An archetype is the set of component classes which are active in an entity. Every
+	entity of a level with the same set belongs to the same archetype, and is stored in
+	its fixed-size chunks, so walking every entity of an archetype (or every entity with
+	some components, going through every archetype which has them) walks contiguous memory
+	instead of chasing pointers entity by entity.
+	Entities are kept packed in chunks: removing one moves the last entity into its place.
+
+	Not to be mistaken for archetypes in the archetypes file, which are data templates
+	entities inherit from. Entities built from them are usually of the same archetype,
+	though, since they've got the same components.
+	*/
+	class CArchetype {
+	public:
+		/**
+		Alias for the set of component classes, as type IDs sorted in ascending order.
+		*/
+		typedef std::vector<unsigned int> TSignature;
+
+	private:
+		/**
+		Alias for the list of chunks.
+		*/
+		typedef std::vector<CArchetypeChunk *> TChunks;
+
+		/**
+		Component classes in this archetype.
+		*/
+		TSignature _signature;
+
+		/**
+		Column of every component class in the chunks, indexed by type ID (INVALID_COLUMN
+		if the class isn't part of the archetype).
+		*/
+		std::vector<unsigned int> _columns;
+
+		/**
+		Chunks in which entities are stored. Only the last one might not be full.
+		*/
+		TChunks _chunks;
+
+		/**
+		How many entities are in this archetype.
+		*/
+		unsigned int _entityCount;
+
+		/**
+		In order to prevent copying its chunks, we declare the copy constructor as private
+		(and never define it) so a compile-time error is shown.
+		*/
+		CArchetype(const CArchetype &archetype);
+
+		/**
+		In order to prevent copying its chunks, we declare the assignment operator as private
+		(and never define it) so a compile-time error is shown.
+		*/
+		CArchetype &operator=(const CArchetype &archetype);
+
+	public:
+		/**
+		Some constants for the structure.
+		*/
+		enum {
+			INVALID_COLUMN = 0xFFFFFFFF
+		};
+
+		/**
+		Basic constructor, given the component classes in the archetype.
+		*/
+		CArchetype(const TSignature &signature);
+
+		/**
+		Basic destructor, frees every chunk.
+		*/
+		~CArchetype();
+
+		/**
+		Gets the component classes in this archetype.
+		*/
+		const TSignature &getSignature() const;
+
+		/**
+		Gets the column of a component class, or INVALID_COLUMN if it isn't part of the archetype.
+		*/
+		unsigned int getColumn(unsigned int type) const;
+
+		/**
+		Gets whether a component class is part of this archetype.
+		*/
+		bool hasType(unsigned int type) const;
+
+		/**
+		Gets whether a component class is part of this archetype, given the class.
+		*/
+		template <typename T>
+		bool hasComponent() const {
+			return hasType(T::componentTypeID);
+		}
+
+		/**
+		Adds an entity, given its active components indexed by type ID, returning where it's been placed.
+		*/
+		unsigned int add(const TEntityID &entity, const std::vector<IComponent *> &componentsByType);
+
+		/**
+		Removes the entity at the given place, moving the last entity into it. Returns the
+		identifier of the moved entity, or CEntityID::UNASSIGNED if none was moved.
+		*/
+		TEntityID remove(unsigned int position);
+
+		/**
+		Gets how many entities are in this archetype.
+		*/
+		unsigned int getEntityCount() const;
+
+		/**
+		Gets how many chunks this archetype has.
+		*/
+		unsigned int getChunkCount() const;
+
+		/**
+		Gets a chunk of this archetype.
+		*/
+		const CArchetypeChunk &getChunk(unsigned int chunk) const;
+
+		/**
+		Gets the column of components of a class within a chunk, given its type ID.
+		The class must be part of this archetype.
+		*/
+		IComponent *const *getComponents(const CArchetypeChunk &chunk, unsigned int type) const;
+
+		/**
+		Gets the component of a class of an entity within a chunk, given the class.
+		The class must be part of this archetype.
+		*/
+		template <typename T>
+		T *getComponent(const CArchetypeChunk &chunk, unsigned int index) const {
+			return static_cast<T *>(getComponents(chunk, T::componentTypeID)[index]);
+		}
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "EntityQuery.h"
+
+#include <cassert>
+
+#include "Application/Macros.h"
+
+namespace EvolvedPlus {
+
+	CEntityQuery::CIterator::CIterator(const TArchetypes &archetypes) :
+		_archetypes(&archetypes), _archetype(0), _chunk(0), _index(0), _currentChunk(NULL) {
+		skipEmpty();
+	}
+
+	void CEntityQuery::CIterator::skipEmpty() {
+		while(_archetype < _archetypes->size()) {
+			const CArchetype &archetype = *(*_archetypes)[_archetype];
+
+			// the current chunk still has entities
+			if(_chunk < archetype.getChunkCount() && _index < archetype.getChunk(_chunk).count) {
+				_currentChunk = &archetype.getChunk(_chunk);
+				return;
+			}
+
+			// chunks are packed, so once one isn't full there's nothing else in the archetype
+			if(_chunk + 1 < archetype.getChunkCount() && _index == ARCHETYPE_CHUNK_SIZE) {
+				_chunk++;
+			} else {
+				_archetype++;
+				_chunk = 0;
+			}
+
+			_index = 0;
+		}
+	}
+
+	bool CEntityQuery::CIterator::isEnd() const {
+		return _archetype >= _archetypes->size();
+	}
+
+	void CEntityQuery::CIterator::next() {
+		// most of the time, we're just moving within the current chunk
+		if(++_index < _currentChunk->count) {
+			return;
+		}
+
+		skipEmpty();
+	}
+
+	const TEntityID &CEntityQuery::CIterator::getEntity() const {
+		return _currentChunk->entities[_index];
+	}
+
+	CEntityQuery::CEntityQuery(const CArchetype::TSignature &types) : _types(types) {
+
+	}
+
+	const CArchetype::TSignature &CEntityQuery::getTypes() const {
+		return _types;
+	}
+
+	bool CEntityQuery::matches(const CArchetype &archetype) const {
+		FOR_IT_CONST(CArchetype::TSignature, it, _types) {
+			if(!archetype.hasType(*it)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void CEntityQuery::addArchetype(const CArchetype &archetype) {
+		if(matches(archetype)) {
+			_archetypes.push_back(&archetype);
+		}
+	}
+
+	void CEntityQuery::clearArchetypes() {
+		_archetypes.clear();
+	}
+
+	unsigned int CEntityQuery::getArchetypeCount() const {
+		return _archetypes.size();
+	}
+
+	const CArchetype &CEntityQuery::getArchetype(unsigned int archetype) const {
+		assert(archetype < _archetypes.size() && "The query doesn't have that many archetypes.");
+
+		return *_archetypes[archetype];
+	}
+
+	unsigned int CEntityQuery::getEntityCount() const {
+		unsigned int count = 0;
+
+		FOR_IT_CONST(TArchetypes, it, _archetypes) {
+			count += (*it)->getEntityCount();
+		}
+
+		return count;
+	}
+
+	CEntityQuery::CIterator CEntityQuery::begin() const {
+		return CIterator(_archetypes);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef EvolvedPlus_EntityQuery_H
+#define EvolvedPlus_EntityQuery_H
+
+#include <vector>
+
+#include "EvolvedPlus/Level/Archetype.h"
+
+namespace EvolvedPlus {
+
+	/**
+	A query is a cached view over every entity of a level which has some components active.
+	Instead of looking for them entity by entity, it keeps the list of archetypes which have
+	those components, which the level keeps up to date as new archetypes appear. Entities
+	move between archetypes as they're added, removed or get components enabled or disabled,
+	so the view is always up to date without doing anything else.
+	Queries are owned by their level, and are obtained through CLevel::query().
+
+	Walking it looks like this:
+	    CEntityQuery &query = level->query<CGraphics, CLight>();
+
+	    for(CEntityQuery::CIterator it = query.begin(); !it.isEnd(); it.next()) {
+	        CGraphics *graphics = it.getComponent<CGraphics>();
+	        ...
+	    }
+
+	Entities shouldn't be added, removed or have components enabled or disabled while
+	walking a query, since they might be moved within their archetypes.
+	*/
+	class CEntityQuery {
+	private:
+		/**
+		Alias for the list of archetypes which match the query.
+		*/
+		typedef std::vector<const CArchetype *> TArchetypes;
+
+		/**
+		Component classes every entity must have, as type IDs sorted in ascending order.
+		*/
+		CArchetype::TSignature _types;
+
+		/**
+		Archetypes which match the query.
+		*/
+		TArchetypes _archetypes;
+
+	public:
+		/**
+		Walks every entity of a query, archetype by archetype and chunk by chunk.
+		*/
+		class CIterator {
+		private:
+			/**
+			Archetypes which are walked.
+			*/
+			const TArchetypes *_archetypes;
+
+			/**
+			Current archetype.
+			*/
+			unsigned int _archetype;
+
+			/**
+			Current chunk within the archetype.
+			*/
+			unsigned int _chunk;
+
+			/**
+			Current entity within the chunk.
+			*/
+			unsigned int _index;
+
+			/**
+			Current chunk, cached so walking it is just moving the index.
+			*/
+			const CArchetypeChunk *_currentChunk;
+
+			/**
+			Skips every empty chunk and archetype, until it finds an entity or the end.
+			*/
+			void skipEmpty();
+
+		public:
+			/**
+			Basic constructor, pointing to the first entity of the given archetypes.
+			*/
+			CIterator(const TArchetypes &archetypes);
+
+			/**
+			Whether every entity has been walked.
+			*/
+			bool isEnd() const;
+
+			/**
+			Moves on to the next entity.
+			*/
+			void next();
+
+			/**
+			Gets the current entity.
+			*/
+			const TEntityID &getEntity() const;
+
+			/**
+			Gets a component of the current entity, given its class.
+			The class must be one of the query's, or part of every archetype walked.
+			*/
+			template <typename T>
+			T *getComponent() const {
+				return (*_archetypes)[_archetype]->getComponent<T>(*_currentChunk, _index);
+			}
+		};
+
+		/**
+		Basic constructor, given the component classes every entity must have.
+		*/
+		CEntityQuery(const CArchetype::TSignature &types);
+
+		/**
+		Gets the component classes every entity must have.
+		*/
+		const CArchetype::TSignature &getTypes() const;
+
+		/**
+		Whether an archetype has every component class of this query.
+		*/
+		bool matches(const CArchetype &archetype) const;
+
+		/**
+		Adds an archetype to the view, if it matches the query.
+		*/
+		void addArchetype(const CArchetype &archetype);
+
+		/**
+		Removes every archetype from the view.
+		*/
+		void clearArchetypes();
+
+		/**
+		Gets how many archetypes match the query.
+		*/
+		unsigned int getArchetypeCount() const;
+
+		/**
+		Gets an archetype which matches the query.
+		*/
+		const CArchetype &getArchetype(unsigned int archetype) const;
+
+		/**
+		Gets how many entities match the query.
+		*/
+		unsigned int getEntityCount() const;
+
+		/**
+		Gets an iterator pointing to the first entity which matches the query.
+		*/
+		CIterator begin() const;
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,13 +1,25 @@
 #include "Level.h"
 
+#include <cassert>
+#include <algorithm>
+
 #include "EvolvedPlus/Components/Component.h"
 #include "EvolvedPlus/Messages/Message.h"
 #include "EvolvedPlus/Messages/MessageTopic.h"
+#include "EvolvedPlus/Profiling/ComponentProfiler.h"
+#include "EvolvedPlus/Profiling/Tracer.h"
+#include "EvolvedPlus/Profiling/StartupProfiler.h"
+#include "EvolvedPlus/Profiling/AllocationTracker.h"
 #include "Application/Macros.h"
+#include "Application/Timer.h"
 
 namespace EvolvedPlus {
 
-	CLevel::CLevel() : _initialized(false), _messageTopic(new Messages::CMessageTopic()) {
+	CLevel::CLevel() : _ticking(false), _activeEntitiesHoles(false), _batchTick(false), _batchesDirty(true),
+		_tickingBatches(false), _batchHoles(false), _unorderedBatches(false), _frameBudget(0.0f), _budgetPriority(0),
+		_budgetCursor(0), _budgetHoles(0), _deferredComponentCount(0),
+		_elapsedTime(0.0), _slowFrameTime(0.0f), _fastFrameTime(0.0f), _adaptiveFrames(1), _slowFrames(0),
+		_fastFrames(0), _messageTopic(new Messages::CMessageTopic()), _initialized(false) {
 
 	}
 
@@ -19,22 +31,35 @@ namespace EvolvedPlus {
 
 		_entitiesToBeDeleted.clear();
 		destroyAllEntities();
+
+		FOR_IT_CONST(TQueries, itQuery, _queries) {
+			delete itQuery->second;
+		}
+
+		_queries.clear();
+		_typedQueries.clear();
 	}
 
 	bool CLevel::initialize() {
 		assert(!_initialized && "A level can't be initialized twice.");
+		Profiling::CStartupPhaseScope phase("CLevel::initialize");
 
 		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData *data = &itEntity->second;
+		for(unsigned int i = 0; i < _entities.size(); ++i) {
+			const CEntityData &data = _entities[i];
 
 			// iterate over entity components and spawn them
-			FOR_IT_CONST(TComponents, itComponent, data->components) {
-				if(!(*itComponent)->spawn(data->data, this)) {
+			FOR_IT_CONST(TComponents, itComponent, data.components) {
+				if(!(*itComponent)->spawn(_entitiesColdData[i].data, this)) {
 					assert(false && "An entity couldn't be spawned correctly.");
 					return false;
 				}
 			}
+
+#ifdef RELEASE_ENTITY_PROPERTIES
+			// components already took what they needed from the data of the entity
+			_entitiesColdData[i].data = CEntityProperties();
+#endif
 		}
 
 		_initialized = true;
@@ -43,10 +68,19 @@ namespace EvolvedPlus {
 
 	bool CLevel::activate() {
 		assert(_initialized && "A level can't be activated before being initialized.");
+		Profiling::CStartupPhaseScope phase("CLevel::activate");
 
-		// iterate over entities (not using a constant iterator because we might have to save data)
-		FOR_IT(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		// entities which were already active are already suscribed, and the ones we activate
+		// are added at the end of the list of active entities
+		unsigned int firstActivated = _activeEntities.size();
+
+		// iterate over entities (by index, since that's what the list of active entities keeps)
+		for(unsigned int i = 0; i < _entities.size(); ++i) {
+			const CEntityData &data = _entities[i];
+
+			if(data.active) {
+				continue;
+			}
 
 			// iterate over entity components and activate them
 			FOR_IT_CONST(TComponents, itComponent, data.components) {
@@ -56,11 +90,12 @@ namespace EvolvedPlus {
 			}
 
 			// entity was activated correctly, so save that
-			itEntity->second.active = true;
+			_entities[i].active = true;
+			addActiveEntity(i);
 		}
 
 		// now that every component is activated, suscribe them all
-		suscribeEntities();
+		suscribeEntities(firstActivated);
 
 		return true;
 	}
@@ -71,125 +106,896 @@ namespace EvolvedPlus {
 		// unsuscribe components from our message topic
 		unsuscribeEntities();
 
-		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		// iterate over active entities
+		FOR_IT_CONST(TEntityIndices, itEntity, _activeEntities) {
+			// it was deactivated while ticking
+			if(*itEntity == INVALID_INDEX) {
+				continue;
+			}
+
+			CEntityData &data = _entities[*itEntity];
 
 			// iterate over entity components and deactivate them
 			FOR_IT_CONST(TComponents, itComponent, data.components) {
 				(*itComponent)->deactivate();
 			}
+
+			FOR_IT_CONST(TComponents, itComponent, data.tickedComponents) {
+				removeFromBatches(*itComponent);
+			}
+
+			data.active = false;
 		}
+
+		_activeEntities.clear();
+		_scheduler.clear();
 	}
 
 	void CLevel::tick(float secs) {
 		assert(_initialized && "A level can't receive tick before being initialized.");
+		TRACE_SCOPE("CLevel::tick");
+		TRACK_ALLOCATION_PHASE(ALLOCATION_TICK);
 
-		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		// the frame budget counts from here
+		CTimer frameTimer;
+		_elapsedTime += secs;
 
-			// iterate over entity components and pass the tick
-			FOR_IT_CONST(TComponents, itComponent, data.components) {
-				(*itComponent)->doTick(secs);
+		// messaging statistics cover a single frame
+		_messageTopic->resetStatistics();
+
+		bool budget = _frameBudget > 0.0f;
+
+		// the groups, and the components which can be deferred, are in use until every
+		// component has been ticked
+		_tickingBatches = _batchTick || budget;
+
+		if(_tickingBatches && _batchesDirty) {
+			rebuildBatches();
+		}
+
+		if(_batchTick) {
+			// iterate over component classes by priority, and pass the tick to all of them (groups
+			// are reached by index, since a component could add a group while ticking and move
+			// them somewhere else in memory)
+			FOR_IT_CONST(std::vector<unsigned int>, itType, _batchOrder) {
+				// components added while ticking to a group which was already ticked wait for the next frame
+				unsigned int count = _componentBatches[*itType].components.size();
+
+				if(count == 0) {
+					continue;
+				}
+
+				TRACE_SCOPE(_componentBatches[*itType].name);
+
+				for(unsigned int i = 0; i < count; ++i) {
+					IComponent *component = _componentBatches[*itType].components[i];
+
+					// it was deactivated while ticking
+					if(component != NULL) {
+						component->doTick(secs);
+					}
+				}
 			}
+		} else {
+			_ticking = true;
+
+			// iterate over active entities (by index, since a component could add entities to the
+			// level while ticking and move them somewhere else in memory)
+			for(unsigned int i = 0; i < _activeEntities.size(); ++i) {
+				unsigned int index = _activeEntities[i];
+
+				// it was deactivated while ticking
+				if(index == INVALID_INDEX) {
+					continue;
+				}
+
+				TRACE_ENTITY_SCOPE("Entity components", _entityIDs[index]);
+
+				// iterate over entity components ticked every frame and pass the tick (they're sorted
+				// by priority, so the ones which can be deferred are the last ones)
+				for(unsigned int j = 0; j < _entities[index].tickedComponents.size(); ++j) {
+					IComponent *component = _entities[index].tickedComponents[j];
+
+					if(budget && component->getPriority() >= _budgetPriority) {
+						break;
+					}
+
+					component->doTick(secs);
+				}
+			}
+
+			_ticking = false;
+
+			if(_activeEntitiesHoles) {
+				packActiveEntities();
+			}
+		}
+
+		// components with an update frequency are only ticked when they're due
+		_scheduler.tick(secs);
+
+		// components with a low priority take whatever is left of the frame budget
+		if(budget) {
+			tickBudgetedComponents(frameTimer);
+		}
+
+		_tickingBatches = false;
+
+		if(_batchHoles) {
+			packBatches();
+		}
+
+		if(_unorderedBatches) {
+			orderBatches();
+		}
+
+		if(_budgetHoles * 2 > _budgetedComponents.size()) {
+			packBudgetedComponents();
 		}
 
 		// now that every entity in the level has receive their tick, we can clean up
 		// pending entities which were requested to be deleted
 		deletePendingEntities();
+
+		// under load, components which can be slowed down are
+		if(_slowFrameTime > 0.0f) {
+			adaptUpdateFrequencies(frameTimer.getElapsedSeconds());
+		}
+
+		// let the profiler know this frame is over (it does nothing unless it's compiled in)
+		PROFILE_COMPONENTS_END_FRAME();
+		TRACK_ALLOCATIONS_END_FRAME();
 	}
 
-	bool CLevel::addEntity(const TEntityID &entity, const CEntityData &entityData) {
-		TEntities::const_iterator it = _entities.find(entity);
+	void CLevel::setBatchTick(bool batchTick) {
+		_batchTick = batchTick;
+		_batchesDirty = true;
+	}
 
-		if(it == _entities.end()) {
-			// create a new entry
-			_entities[entity] = entityData;
+	bool CLevel::isBatchTick() const {
+		return _batchTick;
+	}
 
-			return true;
+	void CLevel::setFrameBudget(float milliseconds, unsigned int priority) {
+		assert(milliseconds >= 0.0f && "A frame budget can't be negative.");
+
+		_frameBudget = milliseconds;
+		_budgetPriority = priority;
+		_deferredComponentCount = 0;
+		_batchesDirty = true;
+		resetBudgetTimes();
+	}
+
+	float CLevel::getFrameBudget() const {
+		return _frameBudget;
+	}
+
+	unsigned int CLevel::getDeferredComponentCount() const {
+		return _deferredComponentCount;
+	}
+
+	void CLevel::tickBudgetedComponents(const CTimer &frameTimer) {
+		TRACE_SCOPE("CLevel::tickBudgetedComponents");
+
+		// components added while ticking wait for the next frame
+		unsigned int count = _budgetedComponents.size();
+		double budget = _frameBudget / 1000.0;
+		_deferredComponentCount = count - _budgetHoles;
+
+		if(_budgetCursor >= count) {
+			_budgetCursor = 0;
 		}
 
-		return false;
+		unsigned int ticked = 0;
+
+		for(unsigned int i = 0; i < count; ++i) {
+			if(ticked > 0 && frameTimer.getElapsedSeconds() >= budget) {
+				break;
+			}
+
+			IComponent *component = _budgetedComponents[_budgetCursor];
+			_budgetCursor = (_budgetCursor + 1) % count;
+
+			// it was deactivated
+			if(component == NULL) {
+				continue;
+			}
+
+			_deferredComponentCount--;
+
+			// it receives every second which passed since it was last ticked
+			component->doTick(static_cast<float>(_elapsedTime - component->_budgetTime));
+			component->_budgetTime = _elapsedTime;
+			ticked++;
+		}
 	}
 
-	bool CLevel::removeEntity(const TEntityID &entity) {
-		TEntities::const_iterator it = _entities.find(entity);
+	void CLevel::resetBudgetTimes() {
+		FOR_IT_CONST(TEntityIndices, itEntity, _activeEntities) {
+			if(*itEntity == INVALID_INDEX) {
+				continue;
+			}
 
-		if(it != _entities.end()) {
-			_entities.erase(it);
-			return true;
+			FOR_IT_CONST(TComponents, itComponent, _entities[*itEntity].components) {
+				(*itComponent)->_budgetTime = _elapsedTime;
+			}
 		}
+	}
 
-		return false;
+	void CLevel::setAdaptiveFrequencies(float slowFrameTime, float fastFrameTime, unsigned int frames) {
+		assert((slowFrameTime == 0.0f || (fastFrameTime < slowFrameTime && frames > 0)) &&
+		       "Fast frames must take less than slow ones, and they must last at least a frame.");
+
+		_slowFrameTime = slowFrameTime;
+		_fastFrameTime = fastFrameTime;
+		_adaptiveFrames = frames;
+		_slowFrames = 0;
+		_fastFrames = 0;
+
+		if(slowFrameTime == 0.0f) {
+			_scheduler.setSlowdown(0);
+		}
 	}
 
-	TEntityID CLevel::getEntityByName(const std::string &name) const {
-		TEntityID entity = CEntityID::UNASSIGNED;
+	unsigned int CLevel::getSlowdown() const {
+		return _scheduler.getSlowdown();
+	}
 
-		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			if(itEntity->second.name == name) {
-				entity = itEntity->first;
-				break;
+	void CLevel::adaptUpdateFrequencies(double frameTime) {
+		float milliseconds = static_cast<float>(frameTime * 1000.0);
+
+		// only frames in a row count, so a single spike doesn't change anything
+		if(milliseconds > _slowFrameTime) {
+			_slowFrames++;
+			_fastFrames = 0;
+		} else if(milliseconds < _fastFrameTime) {
+			_fastFrames++;
+			_slowFrames = 0;
+		} else {
+			_slowFrames = 0;
+			_fastFrames = 0;
+		}
+
+		unsigned int slowdown = _scheduler.getSlowdown();
+
+		if(_slowFrames >= _adaptiveFrames) {
+			_slowFrames = 0;
+
+			if(slowdown < TICK_SCHEDULER_SLOWDOWN_STEPS) {
+				_scheduler.setSlowdown(slowdown + 1);
+			}
+		} else if(_fastFrames >= _adaptiveFrames) {
+			_fastFrames = 0;
+
+			if(slowdown > 0) {
+				_scheduler.setSlowdown(slowdown - 1);
+			}
+		}
+	}
+
+	bool CLevel::isTickedEveryFrame(const IComponent *component) {
+		return component->getUpdateFrequency() == 0.0f && component->getTraits() != IComponent::TRAIT_NONE;
+	}
+
+	bool CLevel::isBudgeted(const IComponent *component) const {
+		return _frameBudget > 0.0f && component->getPriority() >= _budgetPriority;
+	}
+
+	void CLevel::addToBatches(IComponent *component) {
+		// these ones are ticked apart, round-robin, so new ones go at the end
+		if(isBudgeted(component)) {
+			component->_batchPosition = _budgetedComponents.size();
+			_budgetedComponents.push_back(component);
+			return;
+		}
+
+		unsigned int type = component->getTypeID();
+
+		if(type >= _componentBatches.size()) {
+			_componentBatches.resize(type + 1);
+		}
+
+		CComponentBatch &batch = _componentBatches[type];
+		component->_batchPosition = batch.components.size();
+		batch.components.push_back(component);
+
+		if(batch.ordered) {
+			return;
+		}
+
+		batch.name = component->getName().c_str();
+		batch.priority = component->getPriority();
+
+		// groups being ticked can't move, so it waits for the tick to be over
+		if(_tickingBatches) {
+			_unorderedBatches = true;
+		} else {
+			orderBatches();
+		}
+	}
+
+	void CLevel::removeFromBatches(IComponent *component) {
+		unsigned int position = component->_batchPosition;
+
+		// the frame budget could have changed since it was added, so look for it where it is
+		// (moving the last component would change the order of the round-robin, so it always
+		// leaves a hole behind)
+		if(position < _budgetedComponents.size() && _budgetedComponents[position] == component) {
+			_budgetedComponents[position] = NULL;
+			_budgetHoles++;
+
+			if(!_tickingBatches && _budgetHoles * 2 > _budgetedComponents.size()) {
+				packBudgetedComponents();
+			}
+
+			return;
+		}
+
+		TComponents &components = _componentBatches[component->getTypeID()].components;
+		assert(position < components.size() && components[position] == component &&
+		       "The component isn't in its group.");
+
+		// while ticking, moving the last component would make it skip its tick
+		if(_tickingBatches) {
+			components[position] = NULL;
+			_batchHoles = true;
+			return;
+		}
+
+		IComponent *last = components.back();
+		components[position] = last;
+		last->_batchPosition = position;
+		components.pop_back();
+	}
+
+	void CLevel::orderBatches() {
+		for(unsigned int type = 0; type < _componentBatches.size(); ++type) {
+			CComponentBatch &batch = _componentBatches[type];
+
+			if(batch.ordered || batch.components.empty()) {
+				continue;
+			}
+
+			// after every group with the same priority, so earlier groups keep being ticked first
+			std::vector<unsigned int>::iterator it = _batchOrder.begin();
+
+			while(it != _batchOrder.end() && _componentBatches[*it].priority <= batch.priority) {
+				++it;
+			}
+
+			_batchOrder.insert(it, type);
+			batch.ordered = true;
+		}
+
+		_unorderedBatches = false;
+	}
+
+	void CLevel::packBatches() {
+		FOR_IT(TComponentBatches, itBatch, _componentBatches) {
+			packComponents(itBatch->components);
+		}
+
+		_batchHoles = false;
+	}
+
+	void CLevel::packComponents(TComponents &components) {
+		unsigned int packed = 0;
+
+		FOR_IT_CONST(TComponents, itComponent, components) {
+			if(*itComponent != NULL) {
+				(*itComponent)->_batchPosition = packed;
+				components[packed++] = *itComponent;
+			}
+		}
+
+		components.resize(packed);
+	}
+
+	void CLevel::packBudgetedComponents() {
+		unsigned int packed = 0;
+		unsigned int cursor = 0;
+
+		for(unsigned int i = 0; i < _budgetedComponents.size(); ++i) {
+			// the next frame starts with the first component from the cursor on which is still there
+			if(i == _budgetCursor) {
+				cursor = packed;
+			}
+
+			IComponent *component = _budgetedComponents[i];
+
+			if(component != NULL) {
+				component->_batchPosition = packed;
+				_budgetedComponents[packed++] = component;
+			}
+		}
+
+		_budgetedComponents.resize(packed);
+		_budgetCursor = cursor;
+		_budgetHoles = 0;
+	}
+
+	void CLevel::rebuildBatches() {
+		// keep the groups themselves, so their memory is reused
+		FOR_IT(TComponentBatches, itBatch, _componentBatches) {
+			itBatch->components.clear();
+			itBatch->ordered = false;
+		}
+
+		_batchOrder.clear();
+		_budgetedComponents.clear();
+		_budgetCursor = 0;
+		_budgetHoles = 0;
+		_batchHoles = false;
+
+		FOR_IT_CONST(TEntityIndices, itEntity, _activeEntities) {
+			FOR_IT_CONST(TComponents, itComponent, _entities[*itEntity].tickedComponents) {
+				addToBatches(*itComponent);
+			}
+		}
+
+		// components of the same class live side by side, in the order of their addresses
+		FOR_IT(TComponentBatches, itBatch, _componentBatches) {
+			std::sort(itBatch->components.begin(), itBatch->components.end());
+
+			for(unsigned int i = 0; i < itBatch->components.size(); ++i) {
+				itBatch->components[i]->_batchPosition = i;
+			}
+		}
+
+		// groups added along the way are ordered now, if the level is being ticked
+		if(_unorderedBatches) {
+			orderBatches();
+		}
+
+		_batchesDirty = false;
+	}
+
+	bool CLevel::addEntity(const TEntityID &entity, const CEntityData &entityData,
+	                       const CEntityColdData &entityColdData) {
+		assert(entity != CEntityID::UNASSIGNED && "Can't add an entity without an identifier.");
+
+		if(findEntity(entity) != NULL) {
+			return false;
+		}
+
+		unsigned int index = CEntityID::getIndex(entity);
+
+		// a stale entity using the same index could still be here, in that case the
+		// new one must wait for it to be removed
+		if(index >= _entityIndices.size()) {
+			_entityIndices.resize(index + 1, INVALID_INDEX);
+		} else if(_entityIndices[index] != INVALID_INDEX) {
+			return false;
+		}
+
+		// create a new entry at the end
+		_entityIndices[index] = _entities.size();
+		_entities.push_back(entityData);
+		_entitiesColdData.push_back(entityColdData);
+		_entityIDs.push_back(entity);
+		_entities.back().active = false;
+		indexComponents(_entities.back());
+		placeEntity(entity, _entities.back());
+		indexEntityName(entityColdData.name, entity);
+
+		return true;
+	}
+
+	bool CLevel::removeEntity(const TEntityID &entity) {
+		if(findEntity(entity) == NULL) {
+			return false;
+		}
+
+		eraseEntity(entity);
+
+		return true;
+	}
+
+	void CLevel::eraseEntity(const TEntityID &entity) {
+		const CEntityData *data = findEntity(entity);
+
+		unindexEntityName(findEntityColdData(entity)->name, entity);
+		unplaceEntity(*data);
+
+		if(data->active) {
+			removeActiveEntity(*data);
+		}
+
+		// move the last entity into the hole, so entities stay packed together
+		unsigned int index = _entityIndices[CEntityID::getIndex(entity)];
+		unsigned int last = _entities.size() - 1;
+
+		if(index != last) {
+			std::swap(_entities[index], _entities[last]);
+			std::swap(_entitiesColdData[index], _entitiesColdData[last]);
+			_entityIDs[index] = _entityIDs[last];
+			_entityIndices[CEntityID::getIndex(_entityIDs[index])] = index;
+
+			if(_entities[index].active) {
+				_activeEntities[_entities[index].activePosition] = index;
 			}
 		}
 
-		return entity;
+		_entities.pop_back();
+		_entitiesColdData.pop_back();
+		_entityIDs.pop_back();
+		_entityIndices[CEntityID::getIndex(entity)] = INVALID_INDEX;
+	}
+
+	unsigned int CLevel::findEntityIndex(const TEntityID &entity) const {
+		unsigned int index = CEntityID::getIndex(entity);
+
+		if(index >= _entityIndices.size() || _entityIndices[index] == INVALID_INDEX) {
+			return INVALID_INDEX;
+		}
+
+		// the index might belong to another generation of the entity
+		if(_entityIDs[_entityIndices[index]] != entity) {
+			return INVALID_INDEX;
+		}
+
+		return _entityIndices[index];
+	}
+
+	CEntityData *CLevel::findEntity(const TEntityID &entity) {
+		return const_cast<CEntityData *>(static_cast<const CLevel *>(this)->findEntity(entity));
+	}
+
+	const CEntityData *CLevel::findEntity(const TEntityID &entity) const {
+		unsigned int index = findEntityIndex(entity);
+
+		return index != INVALID_INDEX ? &_entities[index] : NULL;
+	}
+
+	CEntityColdData *CLevel::findEntityColdData(const TEntityID &entity) {
+		return const_cast<CEntityColdData *>(static_cast<const CLevel *>(this)->findEntityColdData(entity));
+	}
+
+	const CEntityColdData *CLevel::findEntityColdData(const TEntityID &entity) const {
+		unsigned int index = findEntityIndex(entity);
+
+		return index != INVALID_INDEX ? &_entitiesColdData[index] : NULL;
+	}
+
+	TEntityID CLevel::getEntityByName(const std::string &name) const {
+		TEntityNames::const_iterator it = _entityNames.find(name);
+
+		return it != _entityNames.end() ? it->second : CEntityID::UNASSIGNED;
 	}
 
 	const std::string &CLevel::getEntityName(const TEntityID &entity) const {
-		TEntities::const_iterator it = _entities.find(entity);
-		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
+		const CEntityColdData *data = findEntityColdData(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
 
-		return it->second.name;
+		return data->name;
 	}
 
 	void CLevel::setEntityName(const TEntityID &entity, const std::string &name) {
-		TEntities::iterator it = _entities.find(entity);
-		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
+		CEntityColdData *data = findEntityColdData(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
 
-		it->second.name = name;
+		unindexEntityName(data->name, entity);
+		data->name = name;
+		indexEntityName(name, entity);
 	}
 
 	const std::string &CLevel::getEntityType(const TEntityID &entity) const {
-		TEntities::const_iterator it = _entities.find(entity);
-		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
+		const CEntityColdData *data = findEntityColdData(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
 
-		return it->second.type;
+		return data->type;
 	}
 
 	void CLevel::setEntityType(const TEntityID &entity, const std::string &type) {
-		TEntities::iterator it = _entities.find(entity);
-		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
+		CEntityColdData *data = findEntityColdData(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
 
-		it->second.type = type;
+		data->type = type;
 	}
 
 	bool CLevel::isEntityActive(const TEntityID &entity) const {
-		TEntities::const_iterator it = _entities.find(entity);
-		assert(it != _entities.end() && "Given entity doesn't exist in the current level.");
+		const CEntityData *data = findEntity(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
+
+		return data->active;
+	}
+
+	bool CLevel::setEntityActive(const TEntityID &entity, bool active) {
+		CEntityData *data = findEntity(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
+
+		if(data->active == active) {
+			return true;
+		}
+
+		if(active) {
+			// activate its components, and suscribe them once every one of them is activated
+			FOR_IT_CONST(TComponents, itComponent, data->components) {
+				if(!(*itComponent)->activate()) {
+					// leave the entity as it was, deactivating the ones which were already activated
+					while(itComponent != data->components.begin()) {
+						(*--itComponent)->deactivate();
+					}
+
+					return false;
+				}
+			}
+
+			Messages::CWishList wishList;
 
-		return it->second.active;
+			FOR_IT_CONST(TComponents, itComponent, data->components) {
+				suscribeComponent(*itComponent, wishList);
+			}
+
+			data->active = true;
+			addActiveEntity(_entityIndices[CEntityID::getIndex(entity)]);
+		} else {
+			// just the opposite, unsuscribe it and deactivate its components
+			_messageTopic->unsuscribe(entity);
+
+			FOR_IT_CONST(TComponents, itComponent, data->components) {
+				(*itComponent)->deactivate();
+			}
+
+			data->active = false;
+			removeActiveEntity(*data);
+		}
+
+		return true;
+	}
+
+	unsigned int CLevel::getEntityCount() const {
+		return _entities.size();
+	}
+
+	unsigned int CLevel::getActiveEntityCount() const {
+		if(!_activeEntitiesHoles) {
+			return _activeEntities.size();
+		}
+
+		return _activeEntities.size() - std::count(_activeEntities.begin(), _activeEntities.end(),
+		                                           static_cast<unsigned int>(INVALID_INDEX));
+	}
+
+	void CLevel::addActiveEntity(unsigned int index) {
+		_entities[index].activePosition = _activeEntities.size();
+		_activeEntities.push_back(index);
+
+		FOR_IT_CONST(TComponents, itComponent, _entities[index].components) {
+			if(isScheduled(*itComponent)) {
+				_scheduler.schedule(*itComponent);
+			} else if(isTickedEveryFrame(*itComponent)) {
+				addToBatches(*itComponent);
+			}
+
+			// it wasn't being ticked while it was inactive
+			(*itComponent)->_budgetTime = _elapsedTime;
+		}
+	}
+
+	void CLevel::removeActiveEntity(const CEntityData &data) {
+		FOR_IT_CONST(TComponents, itComponent, data.components) {
+			if(isScheduled(*itComponent)) {
+				_scheduler.unschedule(*itComponent);
+			} else if(isTickedEveryFrame(*itComponent)) {
+				removeFromBatches(*itComponent);
+			}
+		}
+
+		// while ticking, moving the last entity would make it skip its tick
+		if(_ticking) {
+			_activeEntities[data.activePosition] = INVALID_INDEX;
+			_activeEntitiesHoles = true;
+			return;
+		}
+
+		unsigned int last = _activeEntities.back();
+		_activeEntities[data.activePosition] = last;
+		_entities[last].activePosition = data.activePosition;
+		_activeEntities.pop_back();
+	}
+
+	void CLevel::packActiveEntities() {
+		unsigned int packed = 0;
+
+		FOR_IT_CONST(TEntityIndices, itEntity, _activeEntities) {
+			if(*itEntity != INVALID_INDEX) {
+				_entities[*itEntity].activePosition = packed;
+				_activeEntities[packed++] = *itEntity;
+			}
+		}
+
+		_activeEntities.resize(packed);
+		_activeEntitiesHoles = false;
+	}
+
+	void CLevel::getEntities(std::vector<TEntityID> &outEntities) const {
+		outEntities.insert(outEntities.end(), _entityIDs.begin(), _entityIDs.end());
+	}
+
+	bool CLevel::isScheduled(const IComponent *component) {
+		return component->getUpdateFrequency() > 0.0f && component->getTraits() != IComponent::TRAIT_NONE;
+	}
+
+	void CLevel::indexComponents(CEntityData &data) {
+		data.componentsByType.clear();
+		data.tickedComponents.clear();
+
+		// components are sorted by priority, so the first one of each type wins
+		FOR_IT_CONST(TComponents, itComponent, data.components) {
+			unsigned int type = (*itComponent)->getTypeID();
+
+			// the rest of them are ticked by the scheduler, or never
+			if(isTickedEveryFrame(*itComponent)) {
+				data.tickedComponents.push_back(*itComponent);
+			}
+
+			if(type >= data.componentsByType.size()) {
+				data.componentsByType.resize(type + 1, NULL);
+			}
+
+			if(data.componentsByType[type] == NULL) {
+				data.componentsByType[type] = *itComponent;
+			}
+		}
 	}
 
 	void CLevel::destroyAllEntities() {
 		// iterate over entities
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
-
+		for(unsigned int i = 0; i < _entities.size(); ++i) {
 			// iterate over entity components and delete them
-			FOR_IT_CONST(TComponents, itComponent, data.components) {
+			FOR_IT_CONST(TComponents, itComponent, _entities[i].components) {
 				delete *itComponent;
 			}
 
 			// remember to do the same for disabled components
-			FOR_IT_CONST(TComponents, itComponent, data.disabledComponents) {
+			FOR_IT_CONST(TComponents, itComponent, _entitiesColdData[i].disabledComponents) {
 				delete *itComponent;
 			}
 		}
 
+		// entities are gone for good, so their identifiers can be recycled
+		FOR_IT_CONST(TEntityIndices, itEntity, _entityIDs) {
+			CEntityID::releaseID(*itEntity);
+		}
+
 		_entities.clear();
+		_entitiesColdData.clear();
+		_entityIDs.clear();
+		_entityIndices.clear();
+		_activeEntities.clear();
+		_activeEntitiesHoles = false;
+		_scheduler.clear();
+		_entityNames.clear();
+
+		// every component is gone, so this leaves the groups empty
+		rebuildBatches();
+
+		FOR_IT_CONST(TQueries, itQuery, _queries) {
+			itQuery->second->clearArchetypes();
+		}
+
+		FOR_IT_CONST(TArchetypes, itArchetype, _archetypes) {
+			delete *itArchetype;
+		}
+
+		_archetypes.clear();
+		_archetypeIndices.clear();
+	}
+
+	void CLevel::placeEntity(const TEntityID &entity, CEntityData &data) {
+		// the signature of an entity is the type ID of every active component, in ascending order
+		_signature.clear();
+
+		for(unsigned int type = 0; type < data.componentsByType.size(); ++type) {
+			if(data.componentsByType[type] != NULL) {
+				_signature.push_back(type);
+			}
+		}
+
+		TArchetypeIndices::const_iterator it = _archetypeIndices.find(_signature);
+
+		if(it == _archetypeIndices.end()) {
+			it = _archetypeIndices.insert(TArchetypeIndices::value_type(_signature, _archetypes.size())).first;
+			_archetypes.push_back(new CArchetype(_signature));
+
+			// let every query know about the new archetype
+			FOR_IT_CONST(TQueries, itQuery, _queries) {
+				itQuery->second->addArchetype(*_archetypes.back());
+			}
+		}
+
+		data.archetype = it->second;
+		data.archetypePosition = _archetypes[data.archetype]->add(entity, data.componentsByType);
+	}
+
+	void CLevel::unplaceEntity(const CEntityData &data) {
+		TEntityID moved = _archetypes[data.archetype]->remove(data.archetypePosition);
+
+		// the last entity of the archetype took its place
+		if(moved != CEntityID::UNASSIGNED) {
+			findEntity(moved)->archetypePosition = data.archetypePosition;
+		}
+	}
+
+	CEntityQuery &CLevel::query(const CArchetype::TSignature &types) {
+		CArchetype::TSignature sortedTypes(types);
+		std::sort(sortedTypes.begin(), sortedTypes.end());
+		sortedTypes.erase(std::unique(sortedTypes.begin(), sortedTypes.end()), sortedTypes.end());
+
+		TQueries::const_iterator it = _queries.find(sortedTypes);
+
+		if(it != _queries.end()) {
+			return *it->second;
+		}
+
+		// match every archetype we already have, new ones will be added as they appear
+		CEntityQuery *query = new CEntityQuery(sortedTypes);
+
+		FOR_IT_CONST(TArchetypes, itArchetype, _archetypes) {
+			query->addArchetype(**itArchetype);
+		}
+
+		_queries[sortedTypes] = query;
+
+		return *query;
+	}
+
+	unsigned int CLevel::_typedQueryCount = 0;
+
+	unsigned int CLevel::nextTypedQueryID() {
+		return _typedQueryCount++;
+	}
+
+	CEntityQuery *CLevel::getTypedQuery(unsigned int queryID) const {
+		return queryID < _typedQueries.size() ? _typedQueries[queryID] : NULL;
+	}
+
+	CEntityQuery &CLevel::addTypedQuery(unsigned int queryID, const CArchetype::TSignature &types) {
+		if(queryID >= _typedQueries.size()) {
+			_typedQueries.resize(queryID + 1, NULL);
+		}
+
+		_typedQueries[queryID] = &query(types);
+
+		return *_typedQueries[queryID];
+	}
+
+	unsigned int CLevel::getArchetypeCount() const {
+		return _archetypes.size();
+	}
+
+	const CArchetype &CLevel::getArchetype(unsigned int archetype) const {
+		assert(archetype < _archetypes.size() && "The level doesn't have that many archetypes.");
+
+		return *_archetypes[archetype];
+	}
+
+	const CArchetype &CLevel::getEntityArchetype(const TEntityID &entity) const {
+		const CEntityData *data = findEntity(entity);
+		assert(data != NULL && "Given entity doesn't exist in the current level.");
+
+		return *_archetypes[data->archetype];
+	}
+
+	void CLevel::indexEntityName(const std::string &name, const TEntityID &entity) {
+		if(!name.empty()) {
+			_entityNames.insert(TEntityNames::value_type(name, entity));
+		}
+	}
+
+	bool CLevel::unindexEntityName(const std::string &name, const TEntityID &entity) {
+		// several entities might share the same name
+		std::pair<TEntityNames::iterator, TEntityNames::iterator> range = _entityNames.equal_range(name);
+
+		for(TEntityNames::iterator it = range.first; it != range.second; ++it) {
+			if(it->second == entity) {
+				_entityNames.erase(it);
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 	void CLevel::deferDeleteEntity(const TEntityID &entity) {
@@ -197,23 +1003,95 @@ namespace EvolvedPlus {
 	}
 
 	void CLevel::deletePendingEntities() {
-		FOR_IT_CONST(TDeferredEntities, it, _entitiesToBeDeleted) {
+		TRACE_SCOPE("CLevel::deletePendingEntities");
+		TRACK_ALLOCATION_PHASE(ALLOCATION_DEFERRED_DELETION);
+
+		if(_entitiesToBeDeleted.empty()) {
+			return;
+		}
+
+		// components being deactivated or deleted might request more entities to be deleted
+		// (like an entity which destroys its children), and those wait for the next frame
+		_entitiesBeingDeleted.swap(_entitiesToBeDeleted);
+
+		// an entity might have been requested to be deleted more than once in the same frame
+		std::sort(_entitiesBeingDeleted.begin(), _entitiesBeingDeleted.end());
+		_entitiesBeingDeleted.erase(std::unique(_entitiesBeingDeleted.begin(), _entitiesBeingDeleted.end()),
+		                            _entitiesBeingDeleted.end());
+
+		// first of all, unsuscribe every entity at once, so none of them gets messages
+		// sent by components being deactivated
+		FOR_IT_CONST(TDeferredEntities, it, _entitiesBeingDeleted) {
+			_messageTopic->unsuscribe(*it);
+		}
+
+		FOR_IT_CONST(TDeferredEntities, it, _entitiesBeingDeleted) {
 			// an entity which was requested to be deleted should still be in the
 			// level, but there might be an edge case in which something removed
 			// an entity from the level and in the same frame its requested for deletion
-			TEntities::const_iterator itEntity = _entities.find(*it);
-			assert(itEntity != _entities.end() && "An entity marked for deletion doesn't exist in the level.");
+			CEntityData *entity = findEntity(*it);
+			assert(entity != NULL && "An entity marked for deletion doesn't exist in the level.");
 
-			// now delete every component in the entity
-			const CEntityData &data = itEntity->second;
+			if(entity == NULL) {
+				continue;
+			}
 
-			// iterate over entity components and delete them
-			FOR_IT_CONST(TComponents, itComponent, data.components) {
+			// deactivate it if needed, so it isn't ticked or scheduled anymore (by index and
+			// looking the entity up every time, since a component could add entities to the
+			// level while being deactivated and move them somewhere else in memory)
+			if(entity->active) {
+				for(unsigned int i = 0; i < findEntity(*it)->components.size(); ++i) {
+					findEntity(*it)->components[i]->deactivate();
+				}
+
+				entity = findEntity(*it);
+				entity->active = false;
+				removeActiveEntity(*entity);
+			}
+
+			// iterate over entity components and delete them (they're taken out of the entity
+			// first, so destructors adding entities to the level don't matter either)
+			TComponents components;
+			components.swap(findEntity(*it)->components);
+
+			FOR_IT_CONST(TComponents, itComponent, components) {
 				delete *itComponent;
 			}
+
+			// remember to do the same for disabled components (which were already deactivated)
+			components.clear();
+			components.swap(findEntityColdData(*it)->disabledComponents);
+
+			FOR_IT_CONST(TComponents, itComponent, components) {
+				delete *itComponent;
+			}
+
+			// take it out of the level, keeping the rest of entities packed together
+			eraseEntity(*it);
+
+			// and the entity is gone for good, so its identifier can be recycled
+			CEntityID::releaseID(*it);
 		}
 
-		_entitiesToBeDeleted.clear();
+		// requests made meanwhile for entities which are already gone are dropped
+		unsigned int kept = 0;
+
+		FOR_IT_CONST(TDeferredEntities, it, _entitiesToBeDeleted) {
+			if(!std::binary_search(_entitiesBeingDeleted.begin(), _entitiesBeingDeleted.end(), *it)) {
+				_entitiesToBeDeleted[kept++] = *it;
+			}
+		}
+
+		_entitiesToBeDeleted.resize(kept);
+		_entitiesBeingDeleted.clear();
+	}
+
+	const CTickScheduler &CLevel::getScheduler() const {
+		return _scheduler;
+	}
+
+	Messages::CMessageTopic &CLevel::getMessageTopic() {
+		return *_messageTopic;
 	}
 
 	bool CLevel::sendMessage(const TEntityID &destination, Messages::CMessage *message,
@@ -221,29 +1099,38 @@ namespace EvolvedPlus {
 		return _messageTopic->sendMessage(destination, message, emitter);
 	}
 
-	void CLevel::suscribeEntities() {
+	void CLevel::suscribeEntities(unsigned int first) {
 		// temporal WishList to pass around components (we're reusing it, instead of creating more)
 		Messages::CWishList wishList;
 
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			const CEntityData &data = itEntity->second;
+		for(unsigned int i = first; i < _activeEntities.size(); ++i) {
+			const CEntityData &data = _entities[_activeEntities[i]];
 
 			FOR_IT_CONST(TComponents, itComponent, data.components) {
-				// ask the component to tell which messages are important for it
-				(*itComponent)->populateWishList(wishList);
-
-				// now suscribe the component to those messages
-				_messageTopic->suscribe(*itComponent, wishList);
-
-				// and clear our temporal WishList, to get ready for next iteration
-				wishList.clear();
+				suscribeComponent(*itComponent, wishList);
 			}
 		}
 	}
 
+	void CLevel::suscribeComponent(IComponent *component, Messages::CWishList &wishList) {
+		// it would never process them
+		if((component->getTraits() & IComponent::TRAIT_PROCESSES_MESSAGES) == 0) {
+			return;
+		}
+
+		// ask the component to tell which messages are important for it
+		component->populateWishList(wishList);
+
+		// now suscribe the component to those messages
+		_messageTopic->suscribe(component, wishList);
+
+		// and clear our temporal WishList, to get ready for next iteration
+		wishList.clear();
+	}
+
 	void CLevel::unsuscribeEntities() {
-		FOR_IT_CONST(TEntities, itEntity, _entities) {
-			_messageTopic->unsuscribe(itEntity->first);
+		FOR_IT_CONST(TEntityIndices, itEntity, _entityIDs) {
+			_messageTopic->unsuscribe(*itEntity);
 		}
 	}
 
@@ -254,14 +1141,15 @@ namespace EvolvedPlus {
 		}
 
 		// does that component exist in this level? (does its entity exist?)
-		TEntities::iterator itEntity = _entities.find(component->getEntity());
+		CEntityData *entity = findEntity(component->getEntity());
 
-		if(itEntity == _entities.end()) {
+		if(entity == NULL) {
 			return;
 		}
 
-		std::vector<IComponent *> *components = &itEntity->second.components;
-		std::vector<IComponent *> *disabledComponents = &itEntity->second.disabledComponents;
+		std::vector<IComponent *> *components = &entity->components;
+		CEntityColdData *entityColdData = findEntityColdData(component->getEntity());
+		std::vector<IComponent *> *disabledComponents = &entityColdData->disabledComponents;
 
 		if(!active) {
 			// the component is supposed to be active and we want to deactivate it
@@ -274,10 +1162,22 @@ namespace EvolvedPlus {
 			if(itComponent != components->end()) {
 				components->erase(itComponent);
 
-				component->deactivate();
-				_messageTopic->unsuscribe(component);
+				// components of inactive entities are already deactivated and unsuscribed
+				if(entity->active) {
+					component->deactivate();
+					_messageTopic->unsuscribe(component);
+
+					if(isScheduled(component)) {
+						_scheduler.unschedule(component);
+					} else if(isTickedEveryFrame(component)) {
+						removeFromBatches(component);
+					}
+				}
 
 				disabledComponents->push_back(component);
+				indexComponents(*entity);
+				unplaceEntity(*entity);
+				placeEntity(component->getEntity(), *entity);
 			}
 		} else {
 			// the component is supposed to be deactivated and we want to activate it
@@ -290,15 +1190,28 @@ namespace EvolvedPlus {
 			if(itComponent != disabledComponents->end()) {
 				disabledComponents->erase(itComponent);
 
-				Messages::CWishList wishList;
-				component->populateWishList(wishList);
-				_messageTopic->suscribe(component, wishList);
-				component->activate();
+				// components of inactive entities are activated and suscribed along with them
+				if(entity->active) {
+					Messages::CWishList wishList;
+					suscribeComponent(component, wishList);
+					component->activate();
+
+					if(isScheduled(component)) {
+						_scheduler.schedule(component);
+					} else if(isTickedEveryFrame(component)) {
+						addToBatches(component);
+					}
+
+					component->_budgetTime = _elapsedTime;
+				}
 
 				components->push_back(component);
 
 				// re-sort by priority
 				std::sort(components->begin(), components->end(), IComponentComparator());
+				indexComponents(*entity);
+				unplaceEntity(*entity);
+				placeEntity(component->getEntity(), *entity);
 			}
 		}
 	}
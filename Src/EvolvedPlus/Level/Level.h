@@ -3,11 +3,23 @@
 
 #include <vector>
 #include <map>
+#include <string>
+#include <unordered_map>
 
 #include "EvolvedPlus/Entity/EntityID.h"
 #include "EvolvedPlus/Entity/EntityData.h"
+#include "EvolvedPlus/Level/Archetype.h"
+#include "EvolvedPlus/Level/EntityQuery.h"
+#include "EvolvedPlus/Level/TickScheduler.h"
 #include "Application/Macros.h"
 
+/**
+Forward declarations.
+*/
+namespace Application {
+	class CTimer;
+}
+
 namespace EvolvedPlus {
 
 	/**
@@ -18,6 +30,7 @@ namespace EvolvedPlus {
 	namespace Messages {
 		class CMessage;
 		class CMessageTopic;
+		class CWishList;
 	}
 
 	/**
@@ -37,15 +50,85 @@ namespace EvolvedPlus {
 		typedef std::vector<IComponent *> TComponents;
 
 		/**
-		Alias for our map of entities.
+		Alias for our dense list of entities.
+		*/
+		typedef std::vector<CEntityData> TEntities;
+
+		/**
+		Alias for the data of entities which isn't needed every frame.
+		*/
+		typedef std::vector<CEntityColdData> TEntitiesColdData;
+
+		/**
+		Alias for the list of entity identifiers, or for the list of indices of entities.
+		*/
+		typedef std::vector<unsigned int> TEntityIndices;
+
+		/**
+		Some constants for the entity storage.
 		*/
-		typedef std::map<TEntityID, CEntityData> TEntities;
+		enum {
+			INVALID_INDEX = 0xFFFFFFFF
+		};
 
 		/**
-		Map of entities in this level.
+		Entities in this level, packed together without holes so ticking them is a linear walk.
+		Removing an entity moves the last one into its place, so their order isn't kept.
 		*/
 		TEntities _entities;
 
+		/**
+		Data of every entity in _entities which isn't needed every frame, at the same index.
+		It's kept apart so ticking entities doesn't bring it into the cache.
+		*/
+		TEntitiesColdData _entitiesColdData;
+
+		/**
+		Identifier of every entity in _entities, at the same index.
+		*/
+		TEntityIndices _entityIDs;
+
+		/**
+		Index in _entities of every entity, indexed by the index part of its identifier
+		(INVALID_INDEX if no entity with that index is in this level). Those indices are
+		recycled, so this stays as big as the amount of entities alive.
+		*/
+		TEntityIndices _entityIndices;
+
+		/**
+		Index in _entities of every active entity, packed together so ticking only goes
+		through those. Entities deactivated while ticking leave a hole (INVALID_INDEX)
+		behind, which is removed once the tick is over.
+		*/
+		TEntityIndices _activeEntities;
+
+		/**
+		Whether entities are being ticked right now.
+		*/
+		bool _ticking;
+
+		/**
+		Whether _activeEntities has holes which have to be removed.
+		*/
+		bool _activeEntitiesHoles;
+
+		/**
+		Ticks the active components of active entities which have an update frequency, only
+		when they're due.
+		*/
+		CTickScheduler _scheduler;
+
+		/**
+		Alias for the index of entities by name.
+		*/
+		typedef std::unordered_multimap<std::string, TEntityID> TEntityNames;
+
+		/**
+		Every named entity in the level, indexed by its name, so looking for them is O(1).
+		Entities without a name aren't indexed.
+		*/
+		TEntityNames _entityNames;
+
 		/**
 		Alias for a vector of entities which will be deleted.
 		*/
@@ -56,6 +139,222 @@ namespace EvolvedPlus {
 		*/
 		TDeferredEntities _entitiesToBeDeleted;
 
+		/**
+		Entities which are being deleted right now. Entities requested to be deleted meanwhile
+		go to _entitiesToBeDeleted, and wait for the next frame.
+		*/
+		TDeferredEntities _entitiesBeingDeleted;
+
+		/**
+		Alias for the list of archetypes.
+		*/
+		typedef std::vector<CArchetype *> TArchetypes;
+
+		/**
+		Archetypes of the entities in this level, which are only created as entities need them.
+		*/
+		TArchetypes _archetypes;
+
+		/**
+		Alias for the index of archetypes by their component classes.
+		*/
+		typedef std::map<CArchetype::TSignature, unsigned int> TArchetypeIndices;
+
+		/**
+		Index in _archetypes of every archetype, by its component classes.
+		*/
+		TArchetypeIndices _archetypeIndices;
+
+		/**
+		Alias for the index of queries by their component classes.
+		*/
+		typedef std::map<CArchetype::TSignature, CEntityQuery *> TQueries;
+
+		/**
+		Queries made to this level, by their component classes, which are kept up to date.
+		*/
+		TQueries _queries;
+
+		/**
+		How many instantiations of query<T...>() have been given an identifier.
+		*/
+		static unsigned int _typedQueryCount;
+
+		/**
+		Queries asked for through query<T...>(), indexed by the identifier of the instantiation
+		which asked for them (NULL until it does), so asking again every frame doesn't need to
+		build and look up their signature.
+		*/
+		std::vector<CEntityQuery *> _typedQueries;
+
+		/**
+		Gives an identifier to an instantiation of query<T...>().
+		*/
+		static unsigned int nextTypedQueryID();
+
+		/**
+		Gets the query an instantiation of query<T...>() asked for, if it already did.
+		*/
+		CEntityQuery *getTypedQuery(unsigned int queryID) const;
+
+		/**
+		Gets the query with the given component classes, and keeps it as the one asked for by
+		an instantiation of query<T...>().
+		*/
+		CEntityQuery &addTypedQuery(unsigned int queryID, const CArchetype::TSignature &types);
+
+		/**
+		Temporal signature, reused while looking for archetypes so it doesn't allocate memory.
+		*/
+		CArchetype::TSignature _signature;
+
+		/**
+		Active components of every active entity which belong to the same class and are ticked
+		every frame, ticked one after another when ticking by type.
+		*/
+		struct CComponentBatch {
+			/**
+			Components in the group. Components taken out of it while ticking leave a hole (NULL)
+			behind, which is removed once the tick is over.
+			*/
+			TComponents components;
+
+			/**
+			Name of the class of the components, for tracing.
+			*/
+			const char *name;
+
+			/**
+			Priority every component of the class shares.
+			*/
+			unsigned int priority;
+
+			/**
+			Whether the group is already in _batchOrder.
+			*/
+			bool ordered;
+
+			/**
+			Default constructor, the group starts empty and out of _batchOrder.
+			*/
+			CComponentBatch() : name(NULL), priority(0), ordered(false) {
+
+			}
+		};
+
+		/**
+		Alias for the groups of components, indexed by the type ID of their class.
+		*/
+		typedef std::vector<CComponentBatch> TComponentBatches;
+
+		/**
+		Groups of components, indexed by the type ID of their class. They're kept up to date as
+		components come and go, and they're sorted by address when they're rebuilt, so ticking
+		a group walks the chunks of its class.
+		*/
+		TComponentBatches _componentBatches;
+
+		/**
+		Type ID of every group in _componentBatches which has had components, sorted by priority.
+		Groups which become empty stay until they're rebuilt, since there are only a few classes.
+		*/
+		std::vector<unsigned int> _batchOrder;
+
+		/**
+		Whether entities are ticked by type (every component of a class, then every component
+		of the next one) instead of entity by entity.
+		*/
+		bool _batchTick;
+
+		/**
+		Whether the groups of components have to be rebuilt before ticking, because the way
+		they're ticked changed.
+		*/
+		bool _batchesDirty;
+
+		/**
+		Whether the groups of components, or the components under the frame budget, are being
+		ticked right now.
+		*/
+		bool _tickingBatches;
+
+		/**
+		Whether components were taken out of their groups while ticking, leaving holes behind.
+		*/
+		bool _batchHoles;
+
+		/**
+		Whether components were added while ticking to groups which aren't in _batchOrder yet.
+		*/
+		bool _unorderedBatches;
+
+		/**
+		How many milliseconds components with a low priority can take in a frame, 0 meaning
+		there's no budget at all.
+		*/
+		float _frameBudget;
+
+		/**
+		Priority from which components ticked every frame are deferred under a frame budget.
+		Components with a higher priority (a lower number) are always ticked.
+		*/
+		unsigned int _budgetPriority;
+
+		/**
+		Active components of every active entity which can be deferred under a frame budget,
+		ticked round-robin. New ones are added at the end, and the ones which stop being
+		deferred leave a hole (NULL) behind, so the rest of them never change their order.
+		Only used when there's a frame budget.
+		*/
+		TComponents _budgetedComponents;
+
+		/**
+		Position in _budgetedComponents of the next component to be ticked under the frame budget.
+		*/
+		unsigned int _budgetCursor;
+
+		/**
+		How many holes there are in _budgetedComponents. They're removed once they're half of it.
+		*/
+		unsigned int _budgetHoles;
+
+		/**
+		How many components in _budgetedComponents were left for later during the last frame.
+		*/
+		unsigned int _deferredComponentCount;
+
+		/**
+		Sum of every delta time this level has been ticked with, in seconds.
+		*/
+		double _elapsedTime;
+
+		/**
+		Milliseconds a frame has to take, for long enough, before components are slowed down.
+		0 means components are never slowed down.
+		*/
+		float _slowFrameTime;
+
+		/**
+		Milliseconds a frame can take at most, for long enough, before components are sped up again.
+		*/
+		float _fastFrameTime;
+
+		/**
+		How many frames in a row have to be slow or fast before components are slowed down or
+		sped up a step.
+		*/
+		unsigned int _adaptiveFrames;
+
+		/**
+		How many frames in a row have been slow.
+		*/
+		unsigned int _slowFrames;
+
+		/**
+		How many frames in a row have been fast.
+		*/
+		unsigned int _fastFrames;
+
 		/**
 		Message topic responsible of managing messaging and suscriptions.
 		*/
@@ -66,20 +365,182 @@ namespace EvolvedPlus {
 		*/
 		bool _initialized;
 
+		/**
+		Gets the index in _entities of an entity in this level, or INVALID_INDEX if it isn't here.
+		Stale identifiers (of entities which were destroyed, even if their index has been
+		recycled since then) aren't found.
+		*/
+		unsigned int findEntityIndex(const TEntityID &entity) const;
+
+		/**
+		Gets the data of an entity in this level, or NULL if it isn't here.
+		Stale identifiers (of entities which were destroyed, even if their index has been
+		recycled since then) aren't found.
+		*/
+		CEntityData *findEntity(const TEntityID &entity);
+
+		/**
+		Gets the data of an entity in this level, or NULL if it isn't here.
+		*/
+		const CEntityData *findEntity(const TEntityID &entity) const;
+
+		/**
+		Gets the data of an entity in this level which isn't needed every frame, or NULL if
+		it isn't here.
+		*/
+		CEntityColdData *findEntityColdData(const TEntityID &entity);
+
+		/**
+		Gets the data of an entity in this level which isn't needed every frame, or NULL if
+		it isn't here.
+		*/
+		const CEntityColdData *findEntityColdData(const TEntityID &entity) const;
+
+		/**
+		Adds an entity to the index of names.
+		*/
+		void indexEntityName(const std::string &name, const TEntityID &entity);
+
+		/**
+		Removes an entity from the index of names, returning whether it was there.
+		*/
+		bool unindexEntityName(const std::string &name, const TEntityID &entity);
+
+		/**
+		Takes an entity which is in this level out of every index and out of the entity
+		storage, moving the last entity into its place. Its components aren't touched.
+		*/
+		void eraseEntity(const TEntityID &entity);
+
+		/**
+		Adds the entity at an index of _entities to the list of active entities, scheduling
+		its components with an update frequency.
+		*/
+		void addActiveEntity(unsigned int index);
+
+		/**
+		Takes an entity out of the list of active entities, moving the last one into its
+		place (or leaving a hole, while ticking), and unschedules its components.
+		*/
+		void removeActiveEntity(const CEntityData &data);
+
+		/**
+		Removes the holes of the list of active entities, keeping their order.
+		*/
+		void packActiveEntities();
+
+		/**
+		Gets whether a component is ticked by the scheduler of the level, while it's active.
+		Components with an update frequency are, unless they do nothing every frame.
+		*/
+		static bool isScheduled(const IComponent *component);
+
+		/**
+		Creates the suscriptions of a component, unless it doesn't process messages.
+		The given wish list is used as a temporal and it's left empty.
+		*/
+		void suscribeComponent(IComponent *component, Messages::CWishList &wishList);
+
+		/**
+		Rebuilds the index of active components by type of an entity.
+		*/
+		void indexComponents(CEntityData &data);
+
+		/**
+		Places an entity into the archetype of its active components, creating it if needed.
+		*/
+		void placeEntity(const TEntityID &entity, CEntityData &data);
+
+		/**
+		Takes an entity out of its archetype.
+		*/
+		void unplaceEntity(const CEntityData &data);
+
+		/**
+		Gets whether a component is ticked every frame by its level, while it's active.
+		*/
+		static bool isTickedEveryFrame(const IComponent *component);
+
+		/**
+		Gets whether a component ticked every frame is deferred under the frame budget.
+		*/
+		bool isBudgeted(const IComponent *component) const;
+
+		/**
+		Adds a component ticked every frame to its group, or to the components under the frame
+		budget, when it becomes active.
+		*/
+		void addToBatches(IComponent *component);
+
+		/**
+		Takes a component ticked every frame out of its group, or out of the components under
+		the frame budget, when it stops being active.
+		*/
+		void removeFromBatches(IComponent *component);
+
+		/**
+		Puts every group of components which isn't empty and isn't in _batchOrder in its place.
+		*/
+		void orderBatches();
+
+		/**
+		Removes the holes of the groups of components.
+		*/
+		void packBatches();
+
+		/**
+		Removes the holes of some components ticked every frame, keeping their order.
+		*/
+		static void packComponents(TComponents &components);
+
+		/**
+		Removes the holes of the components under the frame budget, keeping their order and
+		the component the next frame starts with.
+		*/
+		void packBudgetedComponents();
+
+		/**
+		Groups the active components of every active entity from scratch, sorting them by
+		address, and gathers the ones which can be deferred when there's a frame budget.
+		*/
+		void rebuildBatches();
+
+		/**
+		Ticks the components which can be deferred, round-robin, starting where the last frame
+		left off, until the frame budget is used up. At least one of them is always ticked, so
+		every component is ticked eventually.
+		*/
+		void tickBudgetedComponents(const Application::CTimer &frameTimer);
+
+		/**
+		Marks every active component as just ticked, so components which start being deferred
+		don't receive the time which passed before that.
+		*/
+		void resetBudgetTimes();
+
+		/**
+		Slows components down a step, or speeds them up a step, when enough frames in a row
+		have taken too long, or little enough.
+		*/
+		void adaptUpdateFrequencies(double frameTime);
+
 		/**
 		Destroys every entity in the level, to be used when the level is destroyed.
 		*/
 		void destroyAllEntities();
 
 		/**
-		Deletes every entity which was requested to be deleted.
+		Deletes every entity which was requested to be deleted, all at once: they're
+		unsuscribed, their components (active and disabled) are deactivated and deleted,
+		and they're taken out of the level, which stays packed together.
 		*/
 		void deletePendingEntities();
 
 		/**
-		Creates suscriptions for every entity in the level.
+		Creates suscriptions for the active entities from the given position of the list
+		of active entities onwards.
 		*/
-		void suscribeEntities();
+		void suscribeEntities(unsigned int first);
 
 		/**
 		Destroys suscriptions for every entity in the level.
@@ -101,6 +562,8 @@ namespace EvolvedPlus {
 		Initializes the level, which means handing data to the entities within it.
 		Must be done prior to level activation.
 		Second part of the two-step initialization.
+		When RELEASE_ENTITY_PROPERTIES is defined, the data of every entity is released once
+		it's been spawned, since components keep what they need from it.
 		*/
 		bool initialize();
 
@@ -115,22 +578,85 @@ namespace EvolvedPlus {
 		void deactivate();
 
 		/**
-		Called once per frame, it will pass the tick to every entity in the level.
+		Called once per frame, it will pass the tick to every active entity in the level.
+		Components with an update frequency are ticked afterwards by the scheduler, and only
+		when they're due. When there's a frame budget, components with a low priority are
+		ticked last, and only while the budget lasts.
 		*/
 		void tick(float secs);
 
+		/**
+		Sets whether entities are ticked by type instead of entity by entity.
+		Ticking by type passes the tick to every component of the class with the highest
+		priority, then to every component of the next class, and so on. Components of each
+		entity are still ticked in the same order, but entities are interleaved.
+		Components enabled while ticking by type are ticked from the next frame on, while
+		components disabled (or of entities deactivated) aren't ticked anymore.
+		*/
+		void setBatchTick(bool batchTick);
+
+		/**
+		Gets whether entities are ticked by type instead of entity by entity.
+		*/
+		bool isBatchTick() const;
+
+		/**
+		Sets how many milliseconds a frame can take before components with a low priority are
+		left for the next frame, 0 meaning they're always ticked.
+		Components ticked every frame with the given priority or a lower one (a higher number)
+		are ticked after every other component, round-robin, until the frame has taken that
+		long. The rest of them are ticked on the next frames, where the last one left off,
+		and receive every second which passed since they were last ticked.
+		Components with an update frequency are never deferred, since the scheduler already
+		spreads them across frames. Changing the frame budget drops the time deferred components
+		were still owed.
+		*/
+		void setFrameBudget(float milliseconds, unsigned int priority);
+
+		/**
+		Gets how many milliseconds a frame can take before components with a low priority are
+		left for the next frame, 0 meaning there's no frame budget.
+		*/
+		float getFrameBudget() const;
+
+		/**
+		Gets how many components with a low priority were left for later during the last frame.
+		*/
+		unsigned int getDeferredComponentCount() const;
+
+		/**
+		Lets the level slow down components which have a slowest update frequency when frames
+		take too long, and speed them up again when frames are fast enough.
+		When the given amount of frames in a row take longer than slowFrameTime milliseconds,
+		the scheduler is slowed down a step. When they take less than fastFrameTime, it's sped
+		up a step. Frames in between reset both counts, so the rate doesn't flip back and forth.
+		A slowFrameTime of 0 turns it off, and brings every component back to its update frequency.
+
+		@see CTickScheduler::setSlowdown
+		*/
+		void setAdaptiveFrequencies(float slowFrameTime, float fastFrameTime, unsigned int frames);
+
+		/**
+		Gets how many steps components which can be slowed down are slowed down right now.
+		*/
+		unsigned int getSlowdown() const;
+
 		/**
 		Adds an entity to the level.
+		It's added inactive, and it's activated along with the level or through setEntityActive.
 		*/
-		bool addEntity(const TEntityID &entity, const CEntityData &entityData);
+		bool addEntity(const TEntityID &entity, const CEntityData &entityData,
+		               const CEntityColdData &entityColdData = CEntityColdData());
 
 		/**
 		Removes an entity from the level.
+		It isn't destroyed, so its identifier is still valid.
 		*/
 		bool removeEntity(const TEntityID &entity);
 
 		/**
 		Retrieves an entity by name.
+		If several entities share the same name, any of them might be returned.
 		*/
 		TEntityID getEntityByName(const std::string &name) const;
 
@@ -159,6 +685,29 @@ namespace EvolvedPlus {
 		*/
 		bool isEntityActive(const TEntityID &entity) const;
 
+		/**
+		Activates or deactivates an entity in this level, returning whether it could be done.
+		Activating it activates its components and suscribes them to their messages, and
+		deactivating it does the opposite. Only active entities are ticked, so dormant
+		entities don't cost anything while the level is ticked.
+		*/
+		bool setEntityActive(const TEntityID &entity, bool active);
+
+		/**
+		Gets how many entities are in the level.
+		*/
+		unsigned int getEntityCount() const;
+
+		/**
+		Gets how many active entities are in the level.
+		*/
+		unsigned int getActiveEntityCount() const;
+
+		/**
+		Fills the given list with the identifier of every entity in the level.
+		*/
+		void getEntities(std::vector<TEntityID> &outEntities) const;
+
 		/**
 		Arguably the most important method related to entities.
 		Since entities are just identifiers, we need to manage communications between
@@ -177,31 +726,118 @@ namespace EvolvedPlus {
 		void deferDeleteEntity(const TEntityID &entity);
 
 		/**
-		Gets a pointer to a component from an entity given the components type.
-		It looks for a component of the given type, which might be O(n) in the worst case,
-		where n is the number of components in the entity.
-		A nicer way of doing that would be to store components indexed by type.
+		Gets a pointer to an active component from an entity given the components type.
+		Every entity keeps its active components indexed by the type ID of their class, so
+		this is O(1). Only components of exactly that class are found, not derived ones.
+		If the entity has more than one, the one with the highest priority is returned.
 		*/
 		template <typename T>
 		T *getComponent(const TEntityID &entity) {
-			TEntities::const_iterator it = _entities.find(entity);
+			const CEntityData *data = findEntity(entity);
 
-			if(it == _entities.end()) {
+			if(data == NULL || T::componentTypeID >= data->componentsByType.size()) {
 				return NULL;
 			}
 
-			const std::type_info &type = typeid(T);
+			return static_cast<T *>(data->componentsByType[T::componentTypeID]);
+		}
+
+		/**
+		Gets whether an entity has an active component of the given type, in O(1).
+		*/
+		template <typename T>
+		bool hasComponent(const TEntityID &entity) const {
+			const CEntityData *data = findEntity(entity);
+
+			return data != NULL && T::componentTypeID < data->componentsByType.size() &&
+			       data->componentsByType[T::componentTypeID] != NULL;
+		}
+
+		/**
+		Gets how many archetypes this level has.
+		Walking every entity with some components is a matter of going through every archetype
+		which has them, and then through their chunks.
+		*/
+		unsigned int getArchetypeCount() const;
+
+		/**
+		Gets an archetype of this level.
+		*/
+		const CArchetype &getArchetype(unsigned int archetype) const;
+
+		/**
+		Gets the archetype an entity belongs to.
+		*/
+		const CArchetype &getEntityArchetype(const TEntityID &entity) const;
+
+		/**
+		Gets a view over every entity in this level which has the given component classes
+		active, as type IDs in any order. Queries are cached, so asking for the same classes
+		again returns the same query, which is kept up to date as entities come and go.
+		*/
+		CEntityQuery &query(const CArchetype::TSignature &types);
+
+		/**
+		Gets a view over every entity in this level which has a component of the given class active.
+		Once asked for, it's remembered by this instantiation, so it can be asked for every
+		frame without allocating memory.
+		*/
+		template <typename T>
+		CEntityQuery &query() {
+			static const unsigned int queryID = nextTypedQueryID();
+
+			CEntityQuery *cached = getTypedQuery(queryID);
+
+			if(cached != NULL) {
+				return *cached;
+			}
+
+			return addTypedQuery(queryID, CArchetype::TSignature(1, T::componentTypeID));
+		}
+
+		/**
+		Gets a view over every entity in this level which has components of the given classes active.
+		Once asked for, it's remembered by this instantiation, so it can be asked for every
+		frame without allocating memory.
+		*/
+		template <typename T, typename U>
+		CEntityQuery &query() {
+			static const unsigned int queryID = nextTypedQueryID();
+
+			CEntityQuery *cached = getTypedQuery(queryID);
+
+			if(cached != NULL) {
+				return *cached;
+			}
+
+			CArchetype::TSignature types;
+			types.push_back(T::componentTypeID);
+			types.push_back(U::componentTypeID);
 
-			FOR_IT_CONST(TComponents, itComponent, it->second.components) {
-				IComponent *component = *itComponent;
+			return addTypedQuery(queryID, types);
+		}
 
-				// remember: dynamic type lookup during run-time dereferencing the pointer
-				if(typeid(*component) == type) {
-					return static_cast<T *>(component);
-				}
+		/**
+		Gets a view over every entity in this level which has components of the given classes active.
+		Once asked for, it's remembered by this instantiation, so it can be asked for every
+		frame without allocating memory.
+		*/
+		template <typename T, typename U, typename V>
+		CEntityQuery &query() {
+			static const unsigned int queryID = nextTypedQueryID();
+
+			CEntityQuery *cached = getTypedQuery(queryID);
+
+			if(cached != NULL) {
+				return *cached;
 			}
 
-			return NULL;
+			CArchetype::TSignature types;
+			types.push_back(T::componentTypeID);
+			types.push_back(U::componentTypeID);
+			types.push_back(V::componentTypeID);
+
+			return addTypedQuery(queryID, types);
 		}
 
 		/**
@@ -211,6 +847,16 @@ namespace EvolvedPlus {
 		*/
 		void setComponentActive(IComponent *component, bool active);
 
+		/**
+		Gets the scheduler of this level, which ticks components with an update frequency.
+		*/
+		const CTickScheduler &getScheduler() const;
+
+		/**
+		Gets the message topic of this level, so messaging statistics can be queried.
+		*/
+		Messages::CMessageTopic &getMessageTopic();
+
 	};
 
 }
@@ -6,6 +6,8 @@
 #include "Level.h"
 #include "LevelEntry.h"
 #include "EvolvedPlus/Entity/EntityFactory.h"
+#include "EvolvedPlus/Config/Config.h"
+#include "EvolvedPlus/Profiling/StartupProfiler.h"
 #include "Application/Macros.h"
 
 namespace EvolvedPlus {
@@ -49,6 +51,8 @@ namespace EvolvedPlus {
 	}
 
 	CLevel *CLevelFactory::build(const std::string &fileName) const {
+		Profiling::CStartupPhaseScope phase("CLevelFactory::build");
+
 		// does the file exist?
 		std::ifstream in(fileName);
 		assert(in && "Level file couldn't be opened.");
@@ -56,6 +60,27 @@ namespace EvolvedPlus {
 		// create the level we'll be building and returning
 		CLevel *level = new CLevel();
 
+		// components can be ticked by type instead of entity by entity
+		bool batchTick = false;
+		CConfig::getInstance().get<bool>("component_batch_tick", batchTick);
+		level->setBatchTick(batchTick);
+
+		// components with a low priority can be left for the next frame when a frame takes too long
+		float frameBudget = 0.0f;
+		unsigned int frameBudgetPriority = 1;
+		CConfig::getInstance().get<float>("frame_budget", frameBudget);
+		CConfig::getInstance().get<unsigned int>("frame_budget_priority", frameBudgetPriority);
+		level->setFrameBudget(frameBudget, frameBudgetPriority);
+
+		// components which can work at a slower update frequency are slowed down under load
+		float adaptiveSlowFrameTime = 0.0f;
+		float adaptiveFastFrameTime = 0.0f;
+		unsigned int adaptiveFrames = 30;
+		CConfig::getInstance().get<float>("adaptive_slow_frame_time", adaptiveSlowFrameTime);
+		CConfig::getInstance().get<float>("adaptive_fast_frame_time", adaptiveFastFrameTime);
+		CConfig::getInstance().get<unsigned int>("adaptive_frames", adaptiveFrames);
+		level->setAdaptiveFrequencies(adaptiveSlowFrameTime, adaptiveFastFrameTime, adaptiveFrames);
+
 		// let's start processing
 		while(!in.eof()) {
 			CLevelEntry levelEntry;
@@ -75,13 +100,14 @@ namespace EvolvedPlus {
 			TEntityID entityID = CEntityID::nextID();
 			CEntityData entity(CEntityFactory::getInstance().build(entityID, properties));
 
-			// now set some properties
-			entity.name = levelEntry.name;
-			entity.type = properties.getType();
-			entity.data = properties;
+			// now set some properties, which are kept apart from what's needed every frame
+			CEntityColdData entityColdData;
+			entityColdData.name = levelEntry.name;
+			entityColdData.type = properties.getType();
+			entityColdData.data = properties;
 
 			// store data for second step when adding to the level
-			level->addEntity(entityID, entity);
+			level->addEntity(entityID, entity, entityColdData);
 		}
 
 		return level;
@@ -0,0 +1,237 @@
+#include "TickScheduler.h"
+
+#include <cassert>
+
+#include "EvolvedPlus/Components/Component.h"
+#include "EvolvedPlus/Profiling/Tracer.h"
+#include "Application/Macros.h"
+
+namespace EvolvedPlus {
+
+	CTickScheduler::CTickScheduler() : _ticking(false), _holes(false), _slowdown(0) {
+
+	}
+
+	CTickScheduler::CGroup &CTickScheduler::getGroup(float frequency, float slowestFrequency) {
+		// there are only a few frequencies
+		FOR_IT(TGroups, itGroup, _groups) {
+			if(itGroup->frequency == frequency && itGroup->slowestFrequency == slowestFrequency) {
+				return *itGroup;
+			}
+		}
+
+		// new groups go at the end, so groups being ticked don't move
+		_groups.push_back(CGroup());
+		CGroup &group = _groups.back();
+		group.frequency = frequency;
+		group.slowestFrequency = slowestFrequency;
+		updatePeriod(group);
+
+		// every phase starts a fraction of the period closer to being due than the previous one
+		for(unsigned int i = 0; i < TICK_SCHEDULER_PHASE_COUNT; ++i) {
+			group.phases[i].elapsed = group.period * i / TICK_SCHEDULER_PHASE_COUNT;
+			group.phases[i].count = 0;
+		}
+
+		return group;
+	}
+
+	void CTickScheduler::updatePeriod(CGroup &group) const {
+		group.period = group.frequency + (group.slowestFrequency - group.frequency) * _slowdown /
+		               TICK_SCHEDULER_SLOWDOWN_STEPS;
+	}
+
+	void CTickScheduler::addToPhase(IComponent *component, CGroup &group, unsigned int phase) {
+		component->_schedulePhase = phase;
+		component->_schedulePosition = group.phases[phase].components.size();
+		group.phases[phase].components.push_back(component);
+		group.phases[phase].count++;
+	}
+
+	void CTickScheduler::schedule(IComponent *component) {
+		assert(component->getUpdateFrequency() > 0.0f && "Only components with an update frequency can be scheduled.");
+
+		CGroup &group = getGroup(component->getUpdateFrequency(), component->getSlowestUpdateFrequency());
+
+		// the emptiest phase takes it
+		unsigned int phase = 0;
+
+		for(unsigned int i = 1; i < TICK_SCHEDULER_PHASE_COUNT; ++i) {
+			if(group.phases[i].count < group.phases[phase].count) {
+				phase = i;
+			}
+		}
+
+		addToPhase(component, group, phase);
+	}
+
+	void CTickScheduler::unschedule(IComponent *component) {
+		CGroup &group = getGroup(component->getUpdateFrequency(), component->getSlowestUpdateFrequency());
+		CPhase &phase = group.phases[component->_schedulePhase];
+		unsigned int position = component->_schedulePosition;
+		assert(position < phase.components.size() && phase.components[position] == component &&
+		       "The component isn't scheduled.");
+
+		phase.count--;
+
+		// while ticking, moving the last component would make it skip its tick
+		if(_ticking) {
+			phase.components[position] = NULL;
+			_holes = true;
+			return;
+		}
+
+		IComponent *last = phase.components.back();
+		phase.components[position] = last;
+		last->_schedulePosition = position;
+		phase.components.pop_back();
+
+		balance(group);
+	}
+
+	void CTickScheduler::balance(CGroup &group) {
+		while(true) {
+			unsigned int emptiest = 0;
+			unsigned int fullest = 0;
+
+			for(unsigned int i = 1; i < TICK_SCHEDULER_PHASE_COUNT; ++i) {
+				if(group.phases[i].count < group.phases[emptiest].count) {
+					emptiest = i;
+				}
+
+				if(group.phases[i].count > group.phases[fullest].count) {
+					fullest = i;
+				}
+			}
+
+			if(group.phases[fullest].count <= group.phases[emptiest].count + 1) {
+				return;
+			}
+
+			// there are no holes while balancing, so the last component is a real one
+			CPhase &phase = group.phases[fullest];
+			IComponent *component = phase.components.back();
+			phase.components.pop_back();
+			phase.count--;
+
+			addToPhase(component, group, emptiest);
+		}
+	}
+
+	void CTickScheduler::tick(float secs) {
+		TRACE_SCOPE("CTickScheduler::tick");
+		_ticking = true;
+
+		// by index, since a component could schedule more of them while ticking, which
+		// might add groups and move them somewhere else in memory
+		for(unsigned int g = 0; g < _groups.size(); ++g) {
+			float period = _groups[g].period;
+
+			for(unsigned int p = 0; p < TICK_SCHEDULER_PHASE_COUNT; ++p) {
+				CPhase &phase = _groups[g].phases[p];
+				phase.elapsed += secs;
+
+				if(phase.elapsed < period) {
+					continue;
+				}
+
+				// how many periods have elapsed since the phase was last due
+				unsigned int times = 0;
+
+				while(phase.elapsed >= period) {
+					phase.elapsed -= period;
+					times++;
+				}
+
+				// components scheduled while ticking wait for the next time their phase is due
+				unsigned int count = phase.components.size();
+
+				for(unsigned int i = 0; i < count; ++i) {
+					IComponent *component = _groups[g].phases[p].components[i];
+
+					if(component != NULL) {
+						component->doDueTick(period, times);
+					}
+				}
+			}
+		}
+
+		_ticking = false;
+
+		if(_holes) {
+			pack();
+		}
+	}
+
+	void CTickScheduler::pack() {
+		FOR_IT(TGroups, itGroup, _groups) {
+			for(unsigned int p = 0; p < TICK_SCHEDULER_PHASE_COUNT; ++p) {
+				TComponents &components = itGroup->phases[p].components;
+				unsigned int packed = 0;
+
+				FOR_IT_CONST(TComponents, itComponent, components) {
+					if(*itComponent != NULL) {
+						(*itComponent)->_schedulePosition = packed;
+						components[packed++] = *itComponent;
+					}
+				}
+
+				components.resize(packed);
+			}
+
+			balance(*itGroup);
+		}
+
+		_holes = false;
+	}
+
+	void CTickScheduler::clear() {
+		_groups.clear();
+		_holes = false;
+	}
+
+	unsigned int CTickScheduler::getComponentCount() const {
+		unsigned int count = 0;
+
+		FOR_IT_CONST(TGroups, itGroup, _groups) {
+			for(unsigned int p = 0; p < TICK_SCHEDULER_PHASE_COUNT; ++p) {
+				count += itGroup->phases[p].count;
+			}
+		}
+
+		return count;
+	}
+
+	void CTickScheduler::setSlowdown(unsigned int slowdown) {
+		assert(slowdown <= TICK_SCHEDULER_SLOWDOWN_STEPS && "The scheduler can't be slowed down that much.");
+
+		// phases keep their elapsed time, so they stay spread along the new period
+		_slowdown = slowdown;
+
+		FOR_IT(TGroups, itGroup, _groups) {
+			updatePeriod(*itGroup);
+		}
+	}
+
+	unsigned int CTickScheduler::getSlowdown() const {
+		return _slowdown;
+	}
+
+	unsigned int CTickScheduler::getGroupCount() const {
+		return _groups.size();
+	}
+
+	float CTickScheduler::getGroupFrequency(unsigned int group) const {
+		assert(group < _groups.size() && "The scheduler doesn't have that many groups.");
+
+		return _groups[group].period;
+	}
+
+	unsigned int CTickScheduler::getPhaseComponentCount(unsigned int group, unsigned int phase) const {
+		assert(group < _groups.size() && "The scheduler doesn't have that many groups.");
+		assert(phase < TICK_SCHEDULER_PHASE_COUNT && "Groups don't have that many phases.");
+
+		return _groups[group].phases[phase].count;
+	}
+
+}
\ No newline at end of file
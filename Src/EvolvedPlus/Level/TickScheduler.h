@@ -0,0 +1,214 @@
+#ifndef EvolvedPlus_TickScheduler_H
+#define EvolvedPlus_TickScheduler_H
+
+#include <vector>
+
+namespace EvolvedPlus {
+
+	/**
+	Forward declarations.
+	*/
+	class IComponent;
+
+	/**
+	How many phases the components of every update frequency are spread across.
+	*/
+#define TICK_SCHEDULER_PHASE_COUNT 16
+
+	/**
+	How many steps it takes to slow components down from their update frequency to the
+	slowest one they can work with.
+	*/
+#define TICK_SCHEDULER_SLOWDOWN_STEPS 4
+
+	/**
+	Components with an update frequency (like TIMES_PER_SECOND(20)) don't need to be
+	visited every frame just to find out they have nothing to do. The scheduler groups
+	them by update frequency, and only passes the tick to the components which are due.
+	Skipped frames don't touch their components at all.
+
+	If every component of a group was due at the same time, frames would spike every time
+	the group is due. Instead, every group is split into TICK_SCHEDULER_PHASE_COUNT phases,
+	evenly spaced along its period, and each of them keeps how much time has elapsed since
+	it was last due. Components are put into the phase with the fewest components, and
+	phases are rebalanced as components are unscheduled, so the cost of a group is spread
+	evenly across the frames of its period.
+
+	Once a phase is due, its components process their messages and receive as many ticks
+	as periods have elapsed, just like IComponent::doTick would do.
+
+	Components which can be slowed down (they have a slowest update frequency) are grouped
+	by both frequencies. The scheduler can be slowed down step by step, up to
+	TICK_SCHEDULER_SLOWDOWN_STEPS, and every step brings the period of those groups closer
+	to their slowest update frequency, so they're ticked less often under load.
+	The scheduler is owned by a level, which schedules the active components of its active
+	entities.
+	*/
+	class CTickScheduler {
+	private:
+		/**
+		Alias for the list of components of a phase.
+		*/
+		typedef std::vector<IComponent *> TComponents;
+
+		/**
+		Components of a group which are due at the same time.
+		*/
+		struct CPhase {
+			/**
+			Time elapsed since the phase was last due.
+			*/
+			float elapsed;
+
+			/**
+			How many components are in the phase, not counting holes.
+			*/
+			unsigned int count;
+
+			/**
+			Components in the phase. Components unscheduled while ticking leave a hole (NULL)
+			behind, which is removed once the tick is over.
+			*/
+			TComponents components;
+		};
+
+		/**
+		Components which share an update frequency and a slowest one.
+		*/
+		struct CGroup {
+			/**
+			Update frequency of every component in the group, in seconds.
+			*/
+			float frequency;
+
+			/**
+			Slowest update frequency of every component in the group, in seconds.
+			*/
+			float slowestFrequency;
+
+			/**
+			Update frequency the group is ticked at right now, given how slowed down the
+			scheduler is, in seconds.
+			*/
+			float period;
+
+			/**
+			Phases of the group, each of them a fraction of the period later than the previous one.
+			*/
+			CPhase phases[TICK_SCHEDULER_PHASE_COUNT];
+		};
+
+		/**
+		Alias for the list of groups.
+		*/
+		typedef std::vector<CGroup> TGroups;
+
+		/**
+		Groups of components, in the order their update frequencies were first scheduled.
+		Groups are kept even when they're empty, since there are only a few frequencies.
+		*/
+		TGroups _groups;
+
+		/**
+		Whether components are being ticked right now.
+		*/
+		bool _ticking;
+
+		/**
+		Whether any phase has holes which have to be removed.
+		*/
+		bool _holes;
+
+		/**
+		How many steps the scheduler is slowed down.
+		*/
+		unsigned int _slowdown;
+
+		/**
+		Gets the group of an update frequency and a slowest one, creating it if needed.
+		*/
+		CGroup &getGroup(float frequency, float slowestFrequency);
+
+		/**
+		Sets the period a group is ticked at, given how slowed down the scheduler is.
+		*/
+		void updatePeriod(CGroup &group) const;
+
+		/**
+		Adds a component at the end of a phase.
+		*/
+		void addToPhase(IComponent *component, CGroup &group, unsigned int phase);
+
+		/**
+		Moves components from the fullest phases of a group to the emptiest ones, until
+		they differ in one component at most.
+		*/
+		void balance(CGroup &group);
+
+		/**
+		Removes the holes of every phase, keeping their order, and balances every group.
+		*/
+		void pack();
+
+	public:
+		/**
+		Default constructor.
+		*/
+		CTickScheduler();
+
+		/**
+		Schedules a component, which must have an update frequency greater than 0.
+		*/
+		void schedule(IComponent *component);
+
+		/**
+		Unschedules a component which was scheduled.
+		*/
+		void unschedule(IComponent *component);
+
+		/**
+		Passes the tick to every component which is due.
+		*/
+		void tick(float secs);
+
+		/**
+		Unschedules every component.
+		*/
+		void clear();
+
+		/**
+		Gets how many components are scheduled.
+		*/
+		unsigned int getComponentCount() const;
+
+		/**
+		Sets how many steps the scheduler is slowed down, from 0 (components are ticked at
+		their update frequency) to TICK_SCHEDULER_SLOWDOWN_STEPS (components are ticked at
+		their slowest update frequency).
+		*/
+		void setSlowdown(unsigned int slowdown);
+
+		/**
+		Gets how many steps the scheduler is slowed down.
+		*/
+		unsigned int getSlowdown() const;
+
+		/**
+		Gets how many update frequencies the scheduled components have.
+		*/
+		unsigned int getGroupCount() const;
+
+		/**
+		Gets the update frequency a group is ticked at right now.
+		*/
+		float getGroupFrequency(unsigned int group) const;
+
+		/**
+		Gets how many components are in a phase of a group.
+		*/
+		unsigned int getPhaseComponentCount(unsigned int group, unsigned int phase) const;
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,19 +1,55 @@
 #include "MessageTopic.h"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 #include "EvolvedPlus/Messages/Message.h"
+#include "EvolvedPlus/Messages/Pool.h"
 #include "EvolvedPlus/Components/Component.h"
+#include "EvolvedPlus/Profiling/Tracer.h"
+#include "EvolvedPlus/Profiling/AllocationTracker.h"
 #include "Application/Macros.h"
 
 namespace EvolvedPlus {
 
 	namespace Messages {
 
-		CMessageTopic::CMessageTopic() {
+		/**
+		A destination entity paired with its statistics, used to find the busiest ones.
+		*/
+		typedef std::pair<TEntityID, const CMessageStatistics *> TEntityStatisticsEntry;
+
+		/**
+		Sorts entities so the ones which were sent more messages come first.
+		*/
+		struct CEntityStatisticsComparator {
+			bool operator()(const TEntityStatisticsEntry &lhs, const TEntityStatisticsEntry &rhs) {
+				return lhs.second->sent > rhs.second->sent;
+			}
+		};
+
+		/**
+		Writes a row of the statistics report.
+		*/
+		static void writeStatistics(std::ostream &os, const std::string &label, const CMessageStatistics &statistics) {
+			os << "\t" << std::left << std::setw(20) << label << std::right
+			   << std::setw(10) << statistics.sent
+			   << std::setw(10) << statistics.delivered
+			   << std::setw(10) << statistics.getAverageFanOut()
+			   << std::setw(10) << statistics.maxFanOut
+			   << std::setw(10) << statistics.dropped
+			   << std::setw(10) << statistics.skippedEmitter << std::endl;
+		}
+
+		CMessageTopic::CMessageTopic() : _statisticsEnabled(false) {
 
 		}
 
 		CMessageTopic::~CMessageTopic() {
 			_suscriptions.clear();
+			_typeStatistics.clear();
+			_entityStatistics.clear();
 		}
 
 		void CMessageTopic::suscribe(IComponent *component, const CWishList &interestList) {
@@ -97,14 +133,24 @@ namespace EvolvedPlus {
 			if(itEntity != _suscriptions.end()) {
 				_suscriptions.erase(itEntity);
 			}
+
+			// identifiers are recycled, so statistics of entities which are gone are forgotten
+			_entityStatistics.erase(entity);
 		}
 
 		bool CMessageTopic::sendMessage(const TEntityID &destination, CMessage *message,
 		                                IComponent *emitter) const {
+			TRACE_ENTITY_SCOPE("CMessageTopic::sendMessage", destination);
+			TRACK_ALLOCATION_PHASE(ALLOCATION_MESSAGE_DELIVERY);
+
 			// due to the nature of the messages in this architecture, we have to check if any
 			// component was interested in the message, or else delete it
 			bool enqueued = false;
 
+			// what we need to know to keep statistics
+			unsigned int fanOut = 0;
+			unsigned int skippedEmitter = 0;
+
 			// first of all, is there any component of the destination entity interested in any message?
 			TEntitySuscriptions::const_iterator itEntity = _suscriptions.find(destination);
 
@@ -116,7 +162,7 @@ namespace EvolvedPlus {
 
 				@see http://en.wikipedia.org/wiki/Typeid
 				*/
-				const type_info *type = &typeid(*message);
+				const std::type_info *type = &typeid(*message);
 
 				// now, is there any component of this entity interested in this message?
 				TSuscriptions::const_iterator itSuscription = itEntity->second.find(type);
@@ -127,11 +173,25 @@ namespace EvolvedPlus {
 						if(*itComponent != emitter) {
 							(*itComponent)->enqueueMessage(message);
 							enqueued = true;
+							fanOut++;
+						} else {
+							skippedEmitter++;
 						}
 					}
 				}
 			}
 
+			if(_statisticsEnabled) {
+				// the message might be released right away, so record it before that happens
+				_statistics.record(fanOut, skippedEmitter);
+				_typeStatistics[&typeid(*message)].record(fanOut, skippedEmitter);
+				// only entities with suscriptions are kept track of, so the statistics of
+				// entities which are gone don't pile up
+				if(itEntity != _suscriptions.end()) {
+					_entityStatistics[destination].record(fanOut, skippedEmitter);
+				}
+			}
+
 			// if nobody was interested in it, then we're safe to delete it
 			if(!enqueued) {
 				message->release();
@@ -140,6 +200,110 @@ namespace EvolvedPlus {
 			return enqueued;
 		}
 
+		void CMessageTopic::setStatisticsEnabled(bool enabled) {
+			_statisticsEnabled = enabled;
+		}
+
+		bool CMessageTopic::isStatisticsEnabled() const {
+			return _statisticsEnabled;
+		}
+
+		void CMessageTopic::resetStatistics() {
+			_statistics.reset();
+
+			FOR_IT(TTypeStatistics, it, _typeStatistics) {
+				it->second.reset();
+			}
+
+			FOR_IT(TEntityStatistics, it, _entityStatistics) {
+				it->second.reset();
+			}
+		}
+
+		const CMessageStatistics &CMessageTopic::getStatistics() const {
+			return _statistics;
+		}
+
+		bool CMessageTopic::getStatistics(const std::type_info &type, CMessageStatistics &outStatistics) const {
+			TTypeStatistics::const_iterator it = _typeStatistics.find(&type);
+
+			if(it == _typeStatistics.end()) {
+				return false;
+			}
+
+			outStatistics = it->second;
+			return true;
+		}
+
+		bool CMessageTopic::getStatistics(const TEntityID &entity, CMessageStatistics &outStatistics) const {
+			TEntityStatistics::const_iterator it = _entityStatistics.find(entity);
+
+			if(it == _entityStatistics.end()) {
+				return false;
+			}
+
+			outStatistics = it->second;
+			return true;
+		}
+
+		const CMessageTopic::TTypeStatistics &CMessageTopic::getTypeStatistics() const {
+			return _typeStatistics;
+		}
+
+		const CMessageTopic::TEntityStatistics &CMessageTopic::getEntityStatistics() const {
+			return _entityStatistics;
+		}
+
+		void CMessageTopic::reportStatistics(std::ostream &os, unsigned int entityCount) const {
+			// keep the stream as it was given to us
+			std::ios::fmtflags flags = os.flags();
+			std::streamsize precision = os.precision();
+			os << std::fixed << std::setprecision(2);
+
+			os << "\t" << std::left << std::setw(20) << "messages" << std::right
+			   << std::setw(10) << "sent"
+			   << std::setw(10) << "delivered"
+			   << std::setw(10) << "avg fan"
+			   << std::setw(10) << "max fan"
+			   << std::setw(10) << "dropped"
+			   << std::setw(10) << "emitter" << std::endl;
+
+			writeStatistics(os, "total", _statistics);
+
+			// by message type, skipping the ones which weren't sent since the last reset
+			CPool &pool = CPool::getInstance();
+
+			FOR_IT_CONST(TTypeStatistics, it, _typeStatistics) {
+				if(it->second.sent > 0) {
+					// messages which aren't in the message file have no name, so use their type
+					writeStatistics(os, pool.hasMessageName(*it->first) ? pool.getMessageName(*it->first) :
+					                    std::string(it->first->name()), it->second);
+				}
+			}
+
+			// busiest destination entities
+			std::vector<TEntityStatisticsEntry> entities;
+
+			FOR_IT_CONST(TEntityStatistics, it, _entityStatistics) {
+				if(it->second.sent > 0) {
+					entities.push_back(TEntityStatisticsEntry(it->first, &it->second));
+				}
+			}
+
+			entityCount = std::min<unsigned int>(entityCount, entities.size());
+			std::partial_sort(entities.begin(), entities.begin() + entityCount, entities.end(),
+			                  CEntityStatisticsComparator());
+
+			for(unsigned int i = 0; i < entityCount; ++i) {
+				std::ostringstream label;
+				label << "entity #" << entities[i].first;
+				writeStatistics(os, label.str(), *entities[i].second);
+			}
+
+			os.flags(flags);
+			os.precision(precision);
+		}
+
 	}
 
 }
\ No newline at end of file
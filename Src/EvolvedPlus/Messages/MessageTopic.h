@@ -4,6 +4,7 @@
 #include <typeinfo>
 #include <map>
 #include <vector>
+#include <ostream>
 
 #include "WishList.h"
 #include "MessageComparator.h"
@@ -22,6 +23,81 @@ namespace EvolvedPlus {
 
 	namespace Messages {
 
+		/**
+		Counters about messages sent through a message topic, either of a single message
+		type, of a single destination entity or of every message at once.
+		*/
+		struct CMessageStatistics {
+			/**
+			How many messages were sent.
+			*/
+			unsigned int sent;
+
+			/**
+			How many times a message was enqueued into a component. A single message
+			is delivered to every component of the destination interested in it.
+			*/
+			unsigned int delivered;
+
+			/**
+			Highest amount of components a single message was delivered to.
+			*/
+			unsigned int maxFanOut;
+
+			/**
+			How many messages were released right away, since no component (other than the
+			emitter) was interested in them.
+			*/
+			unsigned int dropped;
+
+			/**
+			How many times a message wasn't delivered to a component because it was the emitter.
+			*/
+			unsigned int skippedEmitter;
+
+			/**
+			Default constructor.
+			*/
+			CMessageStatistics() {
+				reset();
+			}
+
+			/**
+			Sets every counter back to zero.
+			*/
+			void reset() {
+				sent = 0;
+				delivered = 0;
+				maxFanOut = 0;
+				dropped = 0;
+				skippedEmitter = 0;
+			}
+
+			/**
+			Records a message which was sent.
+			*/
+			void record(unsigned int fanOut, unsigned int skipped) {
+				sent++;
+				delivered += fanOut;
+				skippedEmitter += skipped;
+
+				if(fanOut > maxFanOut) {
+					maxFanOut = fanOut;
+				}
+
+				if(fanOut == 0) {
+					dropped++;
+				}
+			}
+
+			/**
+			Gets how many components, on average, every message was delivered to.
+			*/
+			float getAverageFanOut() const {
+				return sent > 0 ? static_cast<float>(delivered) / sent : 0.0f;
+			}
+		};
+
 		/**
 		Messaging is managed through a message topic which stores which components are
 		interested in which messages.
@@ -56,6 +132,41 @@ namespace EvolvedPlus {
 			*/
 			TEntitySuscriptions _suscriptions;
 
+		public:
+			/**
+			Alias for statistics by message type.
+			*/
+			typedef std::map<const std::type_info *, CMessageStatistics, CMessageComparator> TTypeStatistics;
+
+			/**
+			Alias for statistics by destination entity.
+			*/
+			typedef std::map<TEntityID, CMessageStatistics> TEntityStatistics;
+
+		private:
+			/**
+			Whether statistics are being recorded. They're not by default, since they add a
+			few lookups to every message sent.
+			*/
+			bool _statisticsEnabled;
+
+			/**
+			Statistics of every message sent since they were last reset.
+			They're updated while sending messages, which doesn't modify the topic itself.
+			*/
+			mutable CMessageStatistics _statistics;
+
+			/**
+			Statistics of every message type sent since they were last reset.
+			*/
+			mutable TTypeStatistics _typeStatistics;
+
+			/**
+			Statistics of every destination entity since they were last reset. Only entities
+			with suscriptions are kept, and they're forgotten once unsuscribed.
+			*/
+			mutable TEntityStatistics _entityStatistics;
+
 		public:
 			/**
 			Default constructor.
@@ -87,6 +198,57 @@ namespace EvolvedPlus {
 			Sends a message to any component which was interested in it.
 			*/
 			bool sendMessage(const TEntityID &destination, CMessage *message, IComponent *emitter) const;
+
+			/**
+			Enables or disables recording statistics about sent messages.
+			*/
+			void setStatisticsEnabled(bool enabled);
+
+			/**
+			Whether statistics about sent messages are being recorded.
+			*/
+			bool isStatisticsEnabled() const;
+
+			/**
+			Sets every statistic back to zero. The level does it at the beginning of every
+			tick, so statistics cover a single frame.
+			Known message types and entities are kept, so resetting doesn't free memory that
+			would be allocated again the next frame.
+			*/
+			void resetStatistics();
+
+			/**
+			Gets the statistics of every message sent since they were last reset.
+			*/
+			const CMessageStatistics &getStatistics() const;
+
+			/**
+			Gets the statistics of a message type. Returns false if no message of that type
+			has been sent.
+			*/
+			bool getStatistics(const std::type_info &type, CMessageStatistics &outStatistics) const;
+
+			/**
+			Gets the statistics of a destination entity. Returns false if no message has been
+			sent to that entity.
+			*/
+			bool getStatistics(const TEntityID &entity, CMessageStatistics &outStatistics) const;
+
+			/**
+			Gets the statistics of every message type.
+			*/
+			const TTypeStatistics &getTypeStatistics() const;
+
+			/**
+			Gets the statistics of every destination entity.
+			*/
+			const TEntityStatistics &getEntityStatistics() const;
+
+			/**
+			Writes a human-readable summary of the statistics, with the given amount of busiest
+			destination entities.
+			*/
+			void reportStatistics(std::ostream &os, unsigned int entityCount) const;
 		};
 
 	}
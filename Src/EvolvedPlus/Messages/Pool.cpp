@@ -3,10 +3,13 @@
 #include <cassert>
 #include <algorithm>
 #include <fstream>
+#include <iomanip>
+#include <cmath>
 
 #include "Message.h"
 #include "EvolvedPlus/Config/Config.h"
 #include "EvolvedPlus/Properties.h"
+#include "EvolvedPlus/Profiling/StartupProfiler.h"
 #include "Application/Macros.h"
 
 namespace EvolvedPlus {
@@ -63,6 +66,8 @@ namespace EvolvedPlus {
 		}
 
 		void CPool::initialize() {
+			Profiling::CStartupPhaseScope phase("CPool::initialize");
+
 			// parse message instance count from a file
 			std::string fileName;
 
@@ -94,8 +99,8 @@ namespace EvolvedPlus {
 				_messageNames[type] = itConstructor->first;
 				// create an entry
 				_messages[&typeid(*message)] = CMessageEntry();
-				// get a pointer to the ready instances for easier use
-				TMessageList *built = &_messages[&typeid(*message)].ready;
+				// get a pointer to the entry for easier use
+				CMessageEntry *entry = &_messages[&typeid(*message)];
 
 				// not necessary anymore
 				delete message;
@@ -109,12 +114,16 @@ namespace EvolvedPlus {
 				messageInitData.get<unsigned int>(itConstructor->first, instanceCount);
 
 				for(unsigned int i = 0; i < instanceCount; ++i) {
-					built->push_back(itConstructor->second());
+					entry->ready.push_back(itConstructor->second());
 				}
+
+				entry->initialCount = instanceCount;
 			}
 		}
 
 		void CPool::releaseMessage(CMessage *message) {
+			TRACE_SCOPE("CPool::releaseMessage");
+
 			// evaluating type dynamically in run time, instead of statically during compile time
 			const std::type_info *type = &typeid(*message);
 
@@ -144,6 +153,70 @@ namespace EvolvedPlus {
 			_messageConstructors[name] = instantiator;
 		}
 
+		const std::string &CPool::getMessageName(const std::type_info &type) const {
+			TMessageNames::const_iterator it = _messageNames.find(&type);
+			assert(it != _messageNames.end() && "Trying to get the name of an unregistered message.");
+
+			return it->second;
+		}
+
+		bool CPool::hasMessageName(const std::type_info &type) const {
+			return _messageNames.find(&type) != _messageNames.end();
+		}
+
+		unsigned int CPool::getOverflowCount() const {
+			unsigned int overflowCount = 0;
+
+			FOR_IT_CONST(TMessages, it, _messages) {
+				overflowCount += it->second.overflowCount;
+			}
+
+			return overflowCount;
+		}
+
+		void CPool::reportUsage(std::ostream &os) const {
+			os << "\t" << std::left << std::setw(20) << "message" << std::right
+			   << std::setw(10) << "initial"
+			   << std::setw(10) << "peak"
+			   << std::setw(10) << "overflow" << std::endl;
+
+			FOR_IT_CONST(TMessages, it, _messages) {
+				os << "\t" << std::left << std::setw(20) << getMessageName(*it->first) << std::right
+				   << std::setw(10) << it->second.initialCount
+				   << std::setw(10) << it->second.highWaterMark
+				   << std::setw(10) << it->second.overflowCount << std::endl;
+			}
+		}
+
+		bool CPool::writeTunedSizes(const std::string &fileName, float headroom) const {
+			std::ofstream out(fileName.c_str());
+
+			if(!out) {
+				return false;
+			}
+
+			bool first = true;
+
+			FOR_IT_CONST(TMessages, it, _messages) {
+				const CMessageEntry &entry = it->second;
+				unsigned int instanceCount = entry.initialCount;
+
+				if(entry.highWaterMark > 0) {
+					instanceCount = static_cast<unsigned int>(std::ceil(entry.highWaterMark * (1.0f + headroom)));
+				}
+
+				// one message per line, and the last one can't be followed by an empty line
+				if(!first) {
+					out << std::endl;
+				}
+
+				out << getMessageName(*it->first) << " " << instanceCount;
+				first = false;
+			}
+
+			return true;
+		}
+
 	}
 
 }
\ No newline at end of file
@@ -5,8 +5,11 @@
 #include <vector>
 #include <typeinfo>
 #include <string>
+#include <ostream>
 
 #include "MessageComparator.h"
+#include "EvolvedPlus/Profiling/Tracer.h"
+#include "EvolvedPlus/Profiling/AllocationTracker.h"
 
 namespace EvolvedPlus {
 
@@ -95,6 +98,29 @@ namespace EvolvedPlus {
 				List of messages currently in use.
 				*/
 				TMessageList inUse;
+
+				/**
+				How many messages were built during initialization.
+				*/
+				unsigned int initialCount;
+
+				/**
+				Highest amount of messages which were in use at the same time.
+				*/
+				unsigned int highWaterMark;
+
+				/**
+				How many messages had to be built because there was none ready.
+				Every one of them is an allocation which happened while the game was running.
+				*/
+				unsigned int overflowCount;
+
+				/**
+				Default constructor.
+				*/
+				CMessageEntry() : initialCount(0), highWaterMark(0), overflowCount(0) {
+
+				}
 			};
 
 			/**
@@ -148,6 +174,8 @@ namespace EvolvedPlus {
 			*/
 			template <typename T>
 			T *obtainMessage() {
+				TRACE_SCOPE("CPool::obtainMessage");
+
 				// get map's key
 				const std::type_info *type = &typeid(T);
 
@@ -162,6 +190,8 @@ namespace EvolvedPlus {
 
 				// is there any message ready to be used?
 				if(entry->ready.size() == 0) {
+					TRACK_ALLOCATION_PHASE(ALLOCATION_POOL_OVERFLOW);
+
 					/**
 					Pools can have different policies when they run out of instances to provide.
 					The simplest one is just to return NULL, which indicates we're out of instances.
@@ -175,12 +205,19 @@ namespace EvolvedPlus {
 					peak we'll keep the extra instances even though they might not be used.
 					*/
 					entry->ready.push_back(_messageConstructors[_messageNames[&typeid(T)]]());
+					entry->overflowCount++;
 				}
 
 				// extract a message, add it into the inUse list, and return it
 				T *message = static_cast<T *>(entry->ready.back());
 				entry->ready.pop_back();
 				entry->inUse.push_back(message);
+
+				// keep track of the peak demand, so the pool can be sized to cover it
+				if(entry->inUse.size() > entry->highWaterMark) {
+					entry->highWaterMark = entry->inUse.size();
+				}
+
 				return message;
 			}
 
@@ -193,6 +230,38 @@ namespace EvolvedPlus {
 			Adds a message constructor to the pool.
 			*/
 			void add(const std::string &name, MessageInstantiator instantiator);
+
+			/**
+			Gets the name a message type was registered with.
+			*/
+			const std::string &getMessageName(const std::type_info &type) const;
+
+			/**
+			Gets whether a message type was registered with a name.
+			*/
+			bool hasMessageName(const std::type_info &type) const;
+
+			/**
+			Gets how many messages, of every type, had to be built because there was none ready.
+			*/
+			unsigned int getOverflowCount() const;
+
+			/**
+			Writes, for every message type, how many messages were built during initialization,
+			the highest amount of them in use at the same time and how many had to be built
+			afterwards.
+			*/
+			void reportUsage(std::ostream &os) const;
+
+			/**
+			Writes a message file, in the same format read during initialization, with enough
+			messages of every type to cover the highest demand seen so far plus some headroom
+			(i.e. 0.25 adds a 25%).
+			Types which weren't used keep the amount they were initialized with, since there's
+			no evidence of what they need.
+			Returns false if the file couldn't be written.
+			*/
+			bool writeTunedSizes(const std::string &fileName, float headroom) const;
 		};
 
 	}
@@ -0,0 +1,174 @@
+#include "AllocationTracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+/**
+Replacements of the global operator new and delete, which count every allocation
+before delegating to malloc and free.
+*/
+void *operator new(std::size_t size) {
+	EvolvedPlus::Profiling::CAllocationTracker::recordAllocation();
+
+	void *memory = std::malloc(size > 0 ? size : 1);
+
+	if(!memory) {
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void *operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *memory) throw() {
+	std::free(memory);
+}
+
+void operator delete[](void *memory) throw() {
+	std::free(memory);
+}
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		/**
+		Names of every phase, in the same order they're declared.
+		*/
+		static const char *phaseNames[ALLOCATION_PHASE_COUNT] = {
+			"other",
+			"tick",
+			"message delivery",
+			"pool overflow",
+			"deferred deletion"
+		};
+
+		EAllocationPhase CAllocationTracker::_phase = ALLOCATION_OTHER;
+		unsigned int CAllocationTracker::_frameAllocations[ALLOCATION_PHASE_COUNT] = { 0 };
+		unsigned int CAllocationTracker::_lastFrameAllocations[ALLOCATION_PHASE_COUNT] = { 0 };
+		unsigned int CAllocationTracker::_steadyAllocations[ALLOCATION_PHASE_COUNT] = { 0 };
+		unsigned int CAllocationTracker::_frameCount = 0;
+		unsigned int CAllocationTracker::_warmupFrames = 0;
+		unsigned int CAllocationTracker::_violationCount = 0;
+		unsigned int CAllocationTracker::_firstViolation = 0;
+		unsigned int CAllocationTracker::_pauseCount = 0;
+
+		const char *CAllocationTracker::getPhaseName(EAllocationPhase phase) {
+			return phaseNames[phase];
+		}
+
+		EAllocationPhase CAllocationTracker::setPhase(EAllocationPhase phase) {
+			EAllocationPhase previous = _phase;
+			_phase = phase;
+
+			return previous;
+		}
+
+		void CAllocationTracker::recordAllocation() {
+			if(_pauseCount == 0) {
+				_frameAllocations[_phase]++;
+			}
+		}
+
+		void CAllocationTracker::pause() {
+			_pauseCount++;
+		}
+
+		void CAllocationTracker::resume() {
+			assert(_pauseCount > 0 && "The allocation tracker wasn't paused.");
+
+			_pauseCount--;
+		}
+
+		void CAllocationTracker::setWarmupFrames(unsigned int warmupFrames) {
+			_warmupFrames = warmupFrames;
+		}
+
+		void CAllocationTracker::endFrame() {
+			_frameCount++;
+
+			for(unsigned int i = 0; i < ALLOCATION_PHASE_COUNT; ++i) {
+				_lastFrameAllocations[i] = _frameAllocations[i];
+				_frameAllocations[i] = 0;
+			}
+
+			// frames which are still warming up can allocate as much as they need
+			if(_frameCount <= _warmupFrames) {
+				return;
+			}
+
+			for(unsigned int i = 0; i < ALLOCATION_PHASE_COUNT; ++i) {
+				_steadyAllocations[i] += _lastFrameAllocations[i];
+			}
+
+			if(hasLastFrameViolated()) {
+				if(_violationCount == 0) {
+					_firstViolation = _frameCount;
+				}
+
+				_violationCount++;
+			}
+		}
+
+		unsigned int CAllocationTracker::getFrameCount() {
+			return _frameCount;
+		}
+
+		unsigned int CAllocationTracker::getLastFrameAllocations(EAllocationPhase phase) {
+			return _lastFrameAllocations[phase];
+		}
+
+		unsigned int CAllocationTracker::getLastFrameAllocations() {
+			unsigned int allocations = 0;
+
+			for(unsigned int i = 0; i < ALLOCATION_PHASE_COUNT; ++i) {
+				allocations += _lastFrameAllocations[i];
+			}
+
+			return allocations;
+		}
+
+		bool CAllocationTracker::hasLastFrameViolated() {
+			return _frameCount > _warmupFrames && getLastFrameAllocations() > 0;
+		}
+
+		unsigned int CAllocationTracker::getViolationCount() {
+			return _violationCount;
+		}
+
+		void CAllocationTracker::reportLastFrame(std::ostream &os) {
+			os << "[Allocations] frame " << _frameCount << ": " << getLastFrameAllocations() << std::endl;
+
+			for(unsigned int i = 0; i < ALLOCATION_PHASE_COUNT; ++i) {
+				if(_lastFrameAllocations[i] > 0) {
+					os << "\t" << phaseNames[i] << ": " << _lastFrameAllocations[i] << std::endl;
+				}
+			}
+		}
+
+		void CAllocationTracker::report(std::ostream &os) {
+			os << "[Allocations] " << _frameCount << " frames, " << _warmupFrames << " of them warming up" << std::endl;
+
+			for(unsigned int i = 0; i < ALLOCATION_PHASE_COUNT; ++i) {
+				os << "\t" << phaseNames[i] << ": " << _steadyAllocations[i] << std::endl;
+			}
+
+			if(_violationCount > 0) {
+				os << "\t" << _violationCount << " frames allocated memory after warming up, the first one was frame "
+				   << _firstViolation << std::endl;
+			} else {
+				os << "\tno frame allocated memory after warming up" << std::endl;
+			}
+		}
+
+	}
+
+}
+
+#endif
\ No newline at end of file
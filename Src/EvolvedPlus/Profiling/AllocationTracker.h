@@ -0,0 +1,225 @@
+#ifndef EvolvedPlus_AllocationTracker_H
+#define EvolvedPlus_AllocationTracker_H
+
+#include <ostream>
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		/**
+		What the architecture was doing when some memory was allocated.
+		*/
+		enum EAllocationPhase {
+			ALLOCATION_OTHER = 0,
+			ALLOCATION_TICK,
+			ALLOCATION_MESSAGE_DELIVERY,
+			ALLOCATION_POOL_OVERFLOW,
+			ALLOCATION_DEFERRED_DELETION,
+			ALLOCATION_PHASE_COUNT
+		};
+
+		/**
+		Once a level has warmed up, ticking it shouldn't allocate any memory: that's why
+		messages are pooled. This tracker proves it, counting every allocation performed
+		through the global operator new (which it replaces) and attributing it to the
+		phase the architecture was in.
+		Frames are finished by CLevel::tick, and every frame after the warm-up which
+		allocated something is counted as a violation.
+
+		Its state can't be allocated (we'd be allocating while counting allocations), so
+		it's a class with static methods and plain static data, instead of a singleton.
+		It's only compiled in when TRACK_ALLOCATIONS is defined, since replacing the global
+		operator new affects the whole application. Otherwise, the macros at the end of
+		this file expand to nothing.
+		*/
+		class CAllocationTracker {
+		private:
+			/**
+			Phase the architecture is in right now.
+			*/
+			static EAllocationPhase _phase;
+
+			/**
+			Allocations, by phase, performed during the current frame.
+			*/
+			static unsigned int _frameAllocations[ALLOCATION_PHASE_COUNT];
+
+			/**
+			Allocations, by phase, performed during the last finished frame.
+			*/
+			static unsigned int _lastFrameAllocations[ALLOCATION_PHASE_COUNT];
+
+			/**
+			Allocations, by phase, performed by every frame after the warm-up.
+			*/
+			static unsigned int _steadyAllocations[ALLOCATION_PHASE_COUNT];
+
+			/**
+			How many frames have finished.
+			*/
+			static unsigned int _frameCount;
+
+			/**
+			How many frames are allowed to allocate while warming up.
+			*/
+			static unsigned int _warmupFrames;
+
+			/**
+			How many frames after the warm-up allocated something.
+			*/
+			static unsigned int _violationCount;
+
+			/**
+			First frame after the warm-up which allocated something, if any.
+			*/
+			static unsigned int _firstViolation;
+
+			/**
+			How many pauses are in effect right now. Allocations aren't counted during them.
+			*/
+			static unsigned int _pauseCount;
+
+		public:
+			/**
+			Gets a human-readable name of a phase.
+			*/
+			static const char *getPhaseName(EAllocationPhase phase);
+
+			/**
+			Enters a phase, returning the one we were in so it can be restored later.
+			*/
+			static EAllocationPhase setPhase(EAllocationPhase phase);
+
+			/**
+			Counts an allocation performed in the current phase, unless counting is paused.
+			Called by the global operator new.
+			*/
+			static void recordAllocation();
+
+			/**
+			Stops counting allocations until resume is called. Pauses can be nested.
+			*/
+			static void pause();
+
+			/**
+			Counts allocations again, once every pause has been resumed.
+			*/
+			static void resume();
+
+			/**
+			Sets how many frames are allowed to allocate while warming up.
+			*/
+			static void setWarmupFrames(unsigned int warmupFrames);
+
+			/**
+			Finishes the current frame, checking whether it allocated anything once warmed up.
+			*/
+			static void endFrame();
+
+			/**
+			Gets how many frames have finished.
+			*/
+			static unsigned int getFrameCount();
+
+			/**
+			Gets how many allocations the last finished frame performed in a phase.
+			*/
+			static unsigned int getLastFrameAllocations(EAllocationPhase phase);
+
+			/**
+			Gets how many allocations the last finished frame performed, in every phase.
+			*/
+			static unsigned int getLastFrameAllocations();
+
+			/**
+			Whether the last finished frame allocated something after the warm-up.
+			*/
+			static bool hasLastFrameViolated();
+
+			/**
+			Gets how many frames after the warm-up allocated something.
+			*/
+			static unsigned int getViolationCount();
+
+			/**
+			Writes, by phase, how many allocations were performed by the last finished frame.
+			*/
+			static void reportLastFrame(std::ostream &os);
+
+			/**
+			Writes, by phase, how many allocations were performed after the warm-up, and which
+			frames allocated anything.
+			*/
+			static void report(std::ostream &os);
+		};
+
+		/**
+		Pauses the tracker during its lifetime, for work done between frames (like reports)
+		which isn't part of any of them.
+		*/
+		class CAllocationTrackingPause {
+		public:
+			/**
+			Default constructor, pauses the tracker right away.
+			*/
+			CAllocationTrackingPause() {
+				CAllocationTracker::pause();
+			}
+
+			/**
+			Default destructor, resumes the tracker.
+			*/
+			~CAllocationTrackingPause() {
+				CAllocationTracker::resume();
+			}
+		};
+
+		/**
+		Enters a phase during its lifetime, restoring the previous one afterwards.
+		*/
+		class CAllocationPhaseScope {
+		private:
+			/**
+			Phase we were in before this scope.
+			*/
+			EAllocationPhase _previous;
+
+		public:
+			/**
+			Default constructor, enters the phase right away.
+			*/
+			CAllocationPhaseScope(EAllocationPhase phase) : _previous(CAllocationTracker::setPhase(phase)) {
+
+			}
+
+			/**
+			Default destructor, restores the previous phase.
+			*/
+			~CAllocationPhaseScope() {
+				CAllocationTracker::setPhase(_previous);
+			}
+		};
+
+	}
+
+	/**
+	These next macros are the only way the rest of the architecture should talk to the
+	tracker, so it disappears completely unless TRACK_ALLOCATIONS is defined.
+	*/
+#ifdef TRACK_ALLOCATIONS
+#define TRACK_ALLOCATION_PHASE(phase) \
+	EvolvedPlus::Profiling::CAllocationPhaseScope allocationPhaseScope(EvolvedPlus::Profiling::phase)
+#define TRACK_ALLOCATIONS_END_FRAME() \
+	EvolvedPlus::Profiling::CAllocationTracker::endFrame()
+#define TRACK_ALLOCATIONS_PAUSE() \
+	EvolvedPlus::Profiling::CAllocationTrackingPause allocationTrackingPause
+#else
+#define TRACK_ALLOCATION_PHASE(phase)
+#define TRACK_ALLOCATIONS_END_FRAME()
+#define TRACK_ALLOCATIONS_PAUSE()
+#endif
+
+}
+
+#endif
\ No newline at end of file
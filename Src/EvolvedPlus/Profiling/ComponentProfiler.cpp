@@ -0,0 +1,195 @@
+#include "ComponentProfiler.h"
+
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "EvolvedPlus/Components/Component.h"
+#include "Application/Macros.h"
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		/**
+		A row of a report, pairing a label with the samples it refers to.
+		*/
+		typedef std::pair<std::string, const CComponentSample *> TReportRow;
+
+		/**
+		Sorts rows so the most expensive ones come first.
+		*/
+		struct CReportRowComparator {
+			bool operator()(const TReportRow &lhs, const TReportRow &rhs) {
+				return lhs.second->seconds[DO_TICK] > rhs.second->seconds[DO_TICK];
+			}
+		};
+
+		/**
+		Writes a header for a table of samples.
+		*/
+		static void writeHeader(std::ostream &os, const std::string &label) {
+			os << "\t" << std::left << std::setw(20) << label << std::right
+			   << std::setw(10) << "doTick"
+			   << std::setw(12) << "ms"
+			   << std::setw(12) << "messages"
+			   << std::setw(12) << "ms"
+			   << std::setw(10) << "tick"
+			   << std::setw(12) << "ms" << std::endl;
+		}
+
+		/**
+		Writes the rows of a table of samples, sorted by the time spent in doTick.
+		*/
+		static void writeRows(std::ostream &os, std::vector<TReportRow> &rows) {
+			std::sort(rows.begin(), rows.end(), CReportRowComparator());
+
+			FOR_IT_CONST(std::vector<TReportRow>, it, rows) {
+				const CComponentSample &sample = *it->second;
+
+				os << "\t" << std::left << std::setw(20) << it->first << std::right
+				   << std::setw(10) << sample.calls[DO_TICK]
+				   << std::setw(12) << sample.seconds[DO_TICK] * 1000.0
+				   << std::setw(12) << sample.calls[PROCESS_MESSAGES]
+				   << std::setw(12) << sample.seconds[PROCESS_MESSAGES] * 1000.0
+				   << std::setw(10) << sample.calls[TICK]
+				   << std::setw(12) << sample.seconds[TICK] * 1000.0 << std::endl;
+			}
+		}
+
+		CComponentProfiler *CComponentProfiler::_instance = NULL;
+
+		CComponentProfiler::CComponentProfiler() : _frameCount(0) {
+
+		}
+
+		CComponentProfiler::~CComponentProfiler() {
+			_classProfiles.clear();
+			_priorityProfiles.clear();
+		}
+
+		CComponentProfiler::CComponentProfiler(const CComponentProfiler &factory) {
+			_instance = factory._instance;
+		}
+
+		CComponentProfiler &CComponentProfiler::operator=(const CComponentProfiler &factory) {
+			if(this != &factory) {
+				_instance = factory._instance;
+			}
+
+			return *this;
+		}
+
+		void CComponentProfiler::release() {
+			if(_instance) {
+				delete _instance;
+			}
+
+			_instance = NULL;
+		}
+
+		CComponentProfiler &CComponentProfiler::getInstance() {
+			if(!_instance) {
+				_instance = new CComponentProfiler();
+			}
+
+			return *_instance;
+		}
+
+		void CComponentProfiler::record(const IComponent *component, EComponentSection section, double secs) {
+			// attribute the sample to both the component's class and its priority
+			CComponentSample &classSample = _classProfiles[&component->getName()].currentFrame;
+			classSample.calls[section]++;
+			classSample.seconds[section] += secs;
+
+			CComponentSample &prioritySample = _priorityProfiles[component->getPriority()].currentFrame;
+			prioritySample.calls[section]++;
+			prioritySample.seconds[section] += secs;
+		}
+
+		void CComponentProfiler::endFrame() {
+			// profiles are never erased, so finishing a frame doesn't allocate anything
+			FOR_IT(TClassProfiles, it, _classProfiles) {
+				it->second.run.add(it->second.currentFrame);
+				it->second.lastFrame = it->second.currentFrame;
+				it->second.currentFrame.reset();
+			}
+
+			FOR_IT(TPriorityProfiles, it, _priorityProfiles) {
+				it->second.run.add(it->second.currentFrame);
+				it->second.lastFrame = it->second.currentFrame;
+				it->second.currentFrame.reset();
+			}
+
+			_frameCount++;
+		}
+
+		unsigned int CComponentProfiler::getFrameCount() const {
+			return _frameCount;
+		}
+
+		double CComponentProfiler::getLastFrameSeconds() const {
+			// every component belongs to a priority bucket, and there are less of them than classes
+			double secs = 0.0;
+
+			FOR_IT_CONST(TPriorityProfiles, it, _priorityProfiles) {
+				secs += it->second.lastFrame.seconds[DO_TICK];
+			}
+
+			return secs;
+		}
+
+		void CComponentProfiler::writeTables(std::ostream &os, CComponentSample CComponentProfile::*sample) const {
+			std::vector<TReportRow> rows;
+
+			// by component class
+			FOR_IT_CONST(TClassProfiles, it, _classProfiles) {
+				rows.push_back(TReportRow(*it->first, &(it->second.*sample)));
+			}
+
+			writeHeader(os, "component");
+			writeRows(os, rows);
+			rows.clear();
+
+			// by priority bucket
+			FOR_IT_CONST(TPriorityProfiles, it, _priorityProfiles) {
+				std::ostringstream label;
+				label << "priority " << it->first;
+				rows.push_back(TReportRow(label.str(), &(it->second.*sample)));
+			}
+
+			writeHeader(os, "bucket");
+			writeRows(os, rows);
+		}
+
+		void CComponentProfiler::writeFrameReport(std::ostream &os) const {
+			// keep the stream as it was given to us
+			std::ios::fmtflags flags = os.flags();
+			std::streamsize precision = os.precision();
+			os << std::fixed << std::setprecision(4);
+
+			os << "[Component profiler] frame " << _frameCount << ": "
+			   << getLastFrameSeconds() * 1000.0 << " ms in doTick" << std::endl;
+			writeTables(os, &CComponentProfile::lastFrame);
+
+			os.flags(flags);
+			os.precision(precision);
+		}
+
+		void CComponentProfiler::writeRunReport(std::ostream &os) const {
+			// keep the stream as it was given to us
+			std::ios::fmtflags flags = os.flags();
+			std::streamsize precision = os.precision();
+			os << std::fixed << std::setprecision(4);
+
+			os << "[Component profiler] " << _frameCount << " frames" << std::endl;
+			writeTables(os, &CComponentProfile::run);
+
+			os.flags(flags);
+			os.precision(precision);
+		}
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,275 @@
+#ifndef EvolvedPlus_ComponentProfiler_H
+#define EvolvedPlus_ComponentProfiler_H
+
+#include <string>
+#include <map>
+#include <ostream>
+
+#include "Application/Timer.h"
+
+namespace EvolvedPlus {
+
+	/**
+	Forward declarations.
+	*/
+	class IComponent;
+
+	namespace Profiling {
+
+		/**
+		Every part of a component's update which is measured on its own.
+		DO_TICK includes both PROCESS_MESSAGES and TICK, plus the bookkeeping of the update
+		frequency, so the difference between them is the overhead of doTick itself.
+		*/
+		enum EComponentSection {
+			DO_TICK = 0,
+			PROCESS_MESSAGES,
+			TICK,
+			SECTION_COUNT
+		};
+
+		/**
+		Accumulated wall time and call count of every section of a component's update.
+		*/
+		struct CComponentSample {
+			/**
+			Times every section was executed.
+			*/
+			unsigned int calls[SECTION_COUNT];
+
+			/**
+			Time spent in every section, in seconds.
+			*/
+			double seconds[SECTION_COUNT];
+
+			/**
+			Default constructor.
+			*/
+			CComponentSample() {
+				reset();
+			}
+
+			/**
+			Sets every counter back to zero.
+			*/
+			void reset() {
+				for(unsigned int i = 0; i < SECTION_COUNT; ++i) {
+					calls[i] = 0;
+					seconds[i] = 0.0;
+				}
+			}
+
+			/**
+			Accumulates another sample into this one.
+			*/
+			void add(const CComponentSample &sample) {
+				for(unsigned int i = 0; i < SECTION_COUNT; ++i) {
+					calls[i] += sample.calls[i];
+					seconds[i] += sample.seconds[i];
+				}
+			}
+		};
+
+		/**
+		Samples of a component class (or a priority bucket) during the frame being ticked,
+		the last finished frame and the whole run.
+		*/
+		struct CComponentProfile {
+			/**
+			Samples recorded during the frame being ticked.
+			*/
+			CComponentSample currentFrame;
+
+			/**
+			Samples recorded during the last finished frame.
+			*/
+			CComponentSample lastFrame;
+
+			/**
+			Samples recorded since the profiler was created.
+			*/
+			CComponentSample run;
+		};
+
+		/**
+		Attributes the time spent updating components to their class and their priority,
+		so when a frame spikes we can tell which kind of component caused it.
+		Implemented using a one-step initialization singleton, it's fed by scopes placed in
+		IComponent::doTick and told when a frame finishes by CLevel::tick.
+
+		Since measuring every component of every entity isn't free, it's only compiled in
+		when PROFILE_COMPONENTS is defined. Otherwise, the macros at the end of this file
+		expand to nothing and the architecture doesn't pay anything for it.
+		*/
+		class CComponentProfiler {
+		private:
+			/**
+			Alias for our profiles by component class.
+			Every instance of a class returns the same string from getName(), so its address
+			identifies the class without having to compare strings on every sample.
+			*/
+			typedef std::map<const std::string *, CComponentProfile> TClassProfiles;
+
+			/**
+			Alias for our profiles by priority.
+			*/
+			typedef std::map<unsigned int, CComponentProfile> TPriorityProfiles;
+
+			/**
+			The current and unique instance of the singleton.
+			*/
+			static CComponentProfiler *_instance;
+
+			/**
+			Profiles of every component class which has been ticked.
+			*/
+			TClassProfiles _classProfiles;
+
+			/**
+			Profiles of every priority bucket which has been ticked.
+			*/
+			TPriorityProfiles _priorityProfiles;
+
+			/**
+			How many frames have finished since the profiler was created.
+			*/
+			unsigned int _frameCount;
+
+			/**
+			Basic constructor, private as a part of the singleton pattern.
+			*/
+			CComponentProfiler();
+
+			/**
+			Basic destructor.
+			We can only destruct it from inside, so it's private.
+			*/
+			~CComponentProfiler();
+
+			/**
+			In order to prevent accidental (or intentional) copying of the singleton instance,
+			we declare the copy constructor as private so a compile-time error is shown.
+			*/
+			CComponentProfiler(const CComponentProfiler &factory);
+
+			/**
+			In order to prevent accidental (or intentional) copying of the singleton instance,
+			we declare the assignment operator as private so a compile-time error is shown.
+			*/
+			CComponentProfiler &operator=(const CComponentProfiler &factory);
+
+			/**
+			Writes a table with the selected samples of every class and priority bucket.
+			*/
+			void writeTables(std::ostream &os, CComponentSample CComponentProfile::*sample) const;
+
+		public:
+			/**
+			When the singleton won't be used anymore, we can call this method to destroy the
+			current instance. This is the only way of destroying it and not calling it would
+			leak it.
+			*/
+			static void release();
+
+			/**
+			Gets the instance of this profiler.
+			It's a singleton, and by returning instead of a pointer we are subtly declaring
+			three characteristics:
+			    - It won't be NULL: if it was a pointer, and even if we did our work
+				  initializing it, it could be NULL conceptually.
+				- It can't be changed: a pointer could be pointed somewhere else.
+				- It can't be deleted from outside code: pointers could.
+			*/
+			static CComponentProfiler &getInstance();
+
+			/**
+			Records how long a section of a component's update took, in seconds.
+			*/
+			void record(const IComponent *component, EComponentSection section, double secs);
+
+			/**
+			Finishes the current frame: its samples become the last frame's ones and are
+			accumulated into the run.
+			*/
+			void endFrame();
+
+			/**
+			Gets how many frames have finished.
+			*/
+			unsigned int getFrameCount() const;
+
+			/**
+			Gets the time spent in doTick by every component during the last finished frame.
+			*/
+			double getLastFrameSeconds() const;
+
+			/**
+			Writes what every component class and priority bucket took during the last
+			finished frame.
+			*/
+			void writeFrameReport(std::ostream &os) const;
+
+			/**
+			Writes what every component class and priority bucket took since the profiler
+			was created.
+			*/
+			void writeRunReport(std::ostream &os) const;
+		};
+
+		/**
+		Measures the time elapsed between its construction and destruction, and records it
+		as a section of the given component's update.
+		*/
+		class CComponentProfilerScope {
+		private:
+			/**
+			Component being measured.
+			*/
+			const IComponent *_component;
+
+			/**
+			Section of the update being measured.
+			*/
+			EComponentSection _section;
+
+			/**
+			Time at which the section started, in seconds.
+			*/
+			double _start;
+
+		public:
+			/**
+			Default constructor, starts measuring right away.
+			*/
+			CComponentProfilerScope(const IComponent *component, EComponentSection section) :
+				_component(component), _section(section), _start(CTimer::getSeconds()) {
+
+			}
+
+			/**
+			Default destructor, records the elapsed time.
+			*/
+			~CComponentProfilerScope() {
+				CComponentProfiler::getInstance().record(_component, _section, CTimer::getSeconds() - _start);
+			}
+		};
+
+	}
+
+	/**
+	These next macros are the only way the rest of the architecture should talk to the
+	profiler, so it disappears completely unless PROFILE_COMPONENTS is defined.
+	*/
+#ifdef PROFILE_COMPONENTS
+#define PROFILE_COMPONENT_SECTION(component, section) \
+	Profiling::CComponentProfilerScope componentProfilerScope##section(component, Profiling::section)
+#define PROFILE_COMPONENTS_END_FRAME() \
+	Profiling::CComponentProfiler::getInstance().endFrame()
+#else
+#define PROFILE_COMPONENT_SECTION(component, section)
+#define PROFILE_COMPONENTS_END_FRAME()
+#endif
+
+}
+
+#endif
\ No newline at end of file
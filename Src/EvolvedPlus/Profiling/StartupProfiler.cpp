@@ -0,0 +1,121 @@
+#include "StartupProfiler.h"
+
+#include <cassert>
+#include <iomanip>
+#include <string>
+
+#include "Application/Macros.h"
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		CStartupProfiler *CStartupProfiler::_instance = NULL;
+
+		CStartupProfiler::CStartupProfiler() : _depth(0), _finished(false) {
+
+		}
+
+		CStartupProfiler::~CStartupProfiler() {
+			_phases.clear();
+		}
+
+		CStartupProfiler::CStartupProfiler(const CStartupProfiler &factory) {
+			_instance = factory._instance;
+		}
+
+		CStartupProfiler &CStartupProfiler::operator=(const CStartupProfiler &factory) {
+			if(this != &factory) {
+				_instance = factory._instance;
+			}
+
+			return *this;
+		}
+
+		void CStartupProfiler::release() {
+			if(_instance) {
+				delete _instance;
+			}
+
+			_instance = NULL;
+		}
+
+		CStartupProfiler &CStartupProfiler::getInstance() {
+			if(!_instance) {
+				_instance = new CStartupProfiler();
+			}
+
+			return *_instance;
+		}
+
+		unsigned int CStartupProfiler::beginPhase(const char *name) {
+			if(_finished) {
+				return STARTUP_PHASE_NONE;
+			}
+
+			CStartupPhase phase;
+			phase.name = name;
+			phase.depth = _depth++;
+			phase.duration = 0.0;
+
+			_phases.push_back(phase);
+			return _phases.size() - 1;
+		}
+
+		void CStartupProfiler::endPhase(unsigned int phase, double duration) {
+			if(phase == STARTUP_PHASE_NONE) {
+				return;
+			}
+
+			assert(phase < _phases.size() && _depth > 0 && "Finishing a start up phase which never began.");
+
+			_phases[phase].duration = duration;
+			_depth--;
+		}
+
+		void CStartupProfiler::finish() {
+			_finished = true;
+		}
+
+		bool CStartupProfiler::isFinished() const {
+			return _finished;
+		}
+
+		const std::vector<CStartupPhase> &CStartupProfiler::getPhases() const {
+			return _phases;
+		}
+
+		void CStartupProfiler::report(std::ostream &os) const {
+			// only top level phases add up to the whole start up, the rest happen within them
+			double total = 0.0;
+
+			FOR_IT_CONST(TPhases, it, _phases) {
+				if(it->depth == 0) {
+					total += it->duration;
+				}
+			}
+
+			// keep the stream as it was given to us
+			std::ios::fmtflags flags = os.flags();
+			std::streamsize precision = os.precision();
+			os << std::fixed << std::setprecision(4);
+
+			os << "[Start up] " << total * 1000.0 << " ms" << std::endl;
+
+			FOR_IT_CONST(TPhases, it, _phases) {
+				std::string name = std::string((it->depth + 1) * 2, ' ') + it->name;
+
+				os << std::left << std::setw(40) << name << std::right
+				   << std::setw(12) << it->duration * 1000.0 << " ms"
+				   << std::setw(10) << std::setprecision(1)
+				   << (total > 0.0 ? it->duration / total * 100.0 : 0.0) << " %"
+				   << std::setprecision(4) << std::endl;
+			}
+
+			os.flags(flags);
+			os.precision(precision);
+		}
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#ifndef EvolvedPlus_StartupProfiler_H
+#define EvolvedPlus_StartupProfiler_H
+
+#include <vector>
+#include <ostream>
+
+#include "Application/Timer.h"
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		/**
+		Index given to phases which begin once the start up is over, which aren't recorded.
+		*/
+#define STARTUP_PHASE_NONE 0xFFFFFFFF
+
+		/**
+		A phase of the start up, and how long it took.
+		*/
+		struct CStartupPhase {
+			/**
+			Name of the phase. It must be a string literal, since it's only stored as a pointer.
+			*/
+			const char *name;
+
+			/**
+			How many phases were running when this one started, so phases which happen
+			within others (i.e. parsing the config file the first time it's needed) can be
+			told apart.
+			*/
+			unsigned int depth;
+
+			/**
+			How long the phase took, in seconds.
+			*/
+			double duration;
+		};
+
+		/**
+		Loading a level goes through several phases: parsing files, building entities,
+		spawning and activating them... This profiler records how long every one of them
+		took, so we know which one dominates the start up.
+		Implemented using a one-step initialization singleton, it's fed by scopes placed in
+		every phase. Those phases also happen whenever a level is loaded later on, so once
+		the application tells the start up is over, they aren't recorded anymore. That way
+		the scopes cost next to nothing and can always be compiled in.
+		*/
+		class CStartupProfiler {
+		private:
+			/**
+			Alias for our list of phases.
+			*/
+			typedef std::vector<CStartupPhase> TPhases;
+
+			/**
+			The current and unique instance of the singleton.
+			*/
+			static CStartupProfiler *_instance;
+
+			/**
+			Every recorded phase, in the order they started.
+			*/
+			TPhases _phases;
+
+			/**
+			How many phases are running right now.
+			*/
+			unsigned int _depth;
+
+			/**
+			Whether the start up is over, so new phases aren't recorded.
+			*/
+			bool _finished;
+
+			/**
+			Basic constructor, private as a part of the singleton pattern.
+			*/
+			CStartupProfiler();
+
+			/**
+			Basic destructor.
+			We can only destruct it from inside, so it's private.
+			*/
+			~CStartupProfiler();
+
+			/**
+			In order to prevent accidental (or intentional) copying of the singleton instance,
+			we declare the copy constructor as private so a compile-time error is shown.
+			*/
+			CStartupProfiler(const CStartupProfiler &factory);
+
+			/**
+			In order to prevent accidental (or intentional) copying of the singleton instance,
+			we declare the assignment operator as private so a compile-time error is shown.
+			*/
+			CStartupProfiler &operator=(const CStartupProfiler &factory);
+
+		public:
+			/**
+			When the singleton won't be used anymore, we can call this method to destroy the
+			current instance. This is the only way of destroying it and not calling it would
+			leak it.
+			*/
+			static void release();
+
+			/**
+			Gets the instance of this profiler.
+			It's a singleton, and by returning instead of a pointer we are subtly declaring
+			three characteristics:
+			    - It won't be NULL: if it was a pointer, and even if we did our work
+				  initializing it, it could be NULL conceptually.
+				- It can't be changed: a pointer could be pointed somewhere else.
+				- It can't be deleted from outside code: pointers could.
+			*/
+			static CStartupProfiler &getInstance();
+
+			/**
+			Starts a phase, and returns the index which identifies it (STARTUP_PHASE_NONE if
+			the start up is over).
+			*/
+			unsigned int beginPhase(const char *name);
+
+			/**
+			Finishes a phase, given the index returned when it started.
+			Phases which weren't recorded are ignored.
+			*/
+			void endPhase(unsigned int phase, double duration);
+
+			/**
+			Tells the start up is over, so phases which begin afterwards (i.e. loading another
+			level) aren't recorded.
+			*/
+			void finish();
+
+			/**
+			Gets whether the start up is over.
+			*/
+			bool isFinished() const;
+
+			/**
+			Gets every recorded phase, in the order they started.
+			*/
+			const std::vector<CStartupPhase> &getPhases() const;
+
+			/**
+			Writes every phase as a tree, along with the share of the whole start up it took.
+			*/
+			void report(std::ostream &os) const;
+		};
+
+		/**
+		Measures a start up phase, from its construction until its destruction.
+		*/
+		class CStartupPhaseScope {
+		private:
+			/**
+			Index of the phase being measured.
+			*/
+			unsigned int _phase;
+
+			/**
+			Timer started along with the phase.
+			*/
+			CTimer _timer;
+
+		public:
+			/**
+			Default constructor, starts the phase right away.
+			*/
+			CStartupPhaseScope(const char *name) : _phase(CStartupProfiler::getInstance().beginPhase(name)) {
+				_timer.start();
+			}
+
+			/**
+			Default destructor, finishes the phase.
+			*/
+			~CStartupPhaseScope() {
+				CStartupProfiler::getInstance().endPhase(_phase, _timer.getElapsedSeconds());
+			}
+		};
+
+	}
+
+}
+
+#endif
\ No newline at end of file
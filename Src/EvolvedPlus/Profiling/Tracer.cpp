@@ -0,0 +1,175 @@
+#include "Tracer.h"
+
+#ifdef TRACE_FRAMES
+
+#include <fstream>
+#include <iomanip>
+
+#include "Application/Macros.h"
+
+/**
+Every thread keeps a pointer to its own buffer, so it can record without asking anyone.
+VS2012 doesn't support thread_local, so we rely on each compiler's extension.
+*/
+#ifdef _MSC_VER
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL __thread
+#endif
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		/**
+		Buffer of the current thread, and the generation of the tracer it was registered into
+		(the tracer might have been released and created again since then). Generations start
+		at 1, so 0 means there's no buffer yet.
+		*/
+		static TRACE_THREAD_LOCAL CTraceBuffer *threadBuffer = NULL;
+		static TRACE_THREAD_LOCAL unsigned int threadBufferGeneration = 0;
+
+		CTracer *CTracer::_instance = NULL;
+		unsigned int CTracer::_nextGeneration = 1;
+
+		CTracer::CTracer() : _generation(_nextGeneration++), _capacity(TRACE_DEFAULT_CAPACITY),
+			_origin(CTimer::getSeconds()) {
+
+		}
+
+		CTracer::~CTracer() {
+			FOR_IT_CONST(TBuffers, it, _buffers) {
+				delete *it;
+			}
+
+			_buffers.clear();
+		}
+
+		CTracer::CTracer(const CTracer &factory) {
+			_instance = factory._instance;
+		}
+
+		CTracer &CTracer::operator=(const CTracer &factory) {
+			if(this != &factory) {
+				_instance = factory._instance;
+			}
+
+			return *this;
+		}
+
+		void CTracer::release() {
+			if(_instance) {
+				delete _instance;
+			}
+
+			_instance = NULL;
+		}
+
+		CTracer &CTracer::getInstance() {
+			if(!_instance) {
+				_instance = new CTracer();
+			}
+
+			return *_instance;
+		}
+
+		CTraceBuffer &CTracer::getThreadBuffer() {
+			if(threadBufferGeneration != _generation) {
+				// first time this thread records something, so reserve all its memory right now
+				CTraceBuffer *buffer = new CTraceBuffer();
+				buffer->events.reserve(_capacity);
+				buffer->droppedEvents = 0;
+
+				{
+					std::lock_guard<std::mutex> lock(_buffersMutex);
+					buffer->threadIndex = _buffers.size();
+					_buffers.push_back(buffer);
+				}
+
+				threadBuffer = buffer;
+				threadBufferGeneration = _generation;
+			}
+
+			return *threadBuffer;
+		}
+
+		void CTracer::setCapacity(unsigned int capacity) {
+			_capacity = capacity;
+		}
+
+		void CTracer::record(const char *name, double start, double duration, const TEntityID &entity) {
+			CTraceBuffer &buffer = getThreadBuffer();
+
+			// never grow the buffer, we'd be measuring our own allocations
+			if(buffer.events.size() == buffer.events.capacity()) {
+				buffer.droppedEvents++;
+				return;
+			}
+
+			CTraceEvent event;
+			event.name = name;
+			event.start = start - _origin;
+			event.duration = duration;
+			event.entity = entity;
+			buffer.events.push_back(event);
+		}
+
+		unsigned int CTracer::getDroppedEventCount() const {
+			unsigned int droppedEvents = 0;
+
+			FOR_IT_CONST(TBuffers, it, _buffers) {
+				droppedEvents += (*it)->droppedEvents;
+			}
+
+			return droppedEvents;
+		}
+
+		void CTracer::write(std::ostream &os) const {
+			// complete events ("ph":"X") carry both their start and duration, in microseconds
+			// (keeping nanoseconds, so nested spans don't overlap their parents)
+			bool first = true;
+			std::ios::fmtflags flags = os.flags();
+			std::streamsize precision = os.precision();
+			os << std::fixed << std::setprecision(3);
+
+			os << "{\"traceEvents\":[";
+
+			FOR_IT_CONST(TBuffers, itBuffer, _buffers) {
+				FOR_IT_CONST(CTraceBuffer::TEvents, itEvent, (*itBuffer)->events) {
+					os << (first ? "\n" : ",\n");
+					os << "{\"name\":\"" << itEvent->name << "\",\"cat\":\"EvolvedPlus\",\"ph\":\"X\""
+					   << ",\"ts\":" << itEvent->start * 1000000.0
+					   << ",\"dur\":" << itEvent->duration * 1000000.0
+					   << ",\"pid\":1,\"tid\":" << (*itBuffer)->threadIndex;
+
+					if(itEvent->entity != CEntityID::UNASSIGNED) {
+						os << ",\"args\":{\"entity\":" << itEvent->entity << "}";
+					}
+
+					os << "}";
+					first = false;
+				}
+			}
+
+			os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+			os.flags(flags);
+			os.precision(precision);
+		}
+
+		bool CTracer::write(const std::string &fileName) const {
+			std::ofstream out(fileName.c_str());
+
+			if(!out) {
+				return false;
+			}
+
+			write(out);
+			return true;
+		}
+
+	}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,272 @@
+#ifndef EvolvedPlus_Tracer_H
+#define EvolvedPlus_Tracer_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#ifdef TRACE_FRAMES
+#include <mutex>
+#endif
+
+#include "EvolvedPlus/Entity/EntityID.h"
+#include "Application/Timer.h"
+
+namespace EvolvedPlus {
+
+	namespace Profiling {
+
+		/**
+		Default amount of events every thread can record before new ones are dropped.
+		*/
+#define TRACE_DEFAULT_CAPACITY 1048576
+
+		/**
+		A span of time spent in some part of the architecture.
+		*/
+		struct CTraceEvent {
+			/**
+			What was being executed. It must be a string literal, since it's only stored
+			as a pointer to avoid copying strings while recording.
+			*/
+			const char *name;
+
+			/**
+			Time at which the span started, in seconds.
+			*/
+			double start;
+
+			/**
+			How long the span took, in seconds.
+			*/
+			double duration;
+
+			/**
+			Entity the span refers to, if any.
+			*/
+			TEntityID entity;
+		};
+
+		/**
+		Events recorded by a single thread.
+		Only the thread which owns it writes into it, so recording doesn't need any lock.
+		Its memory is reserved when it's created, and once it's full new events are dropped
+		instead of growing it, so recording never allocates memory.
+		*/
+		struct CTraceBuffer {
+			/**
+			Alias for our list of events.
+			*/
+			typedef std::vector<CTraceEvent> TEvents;
+
+			/**
+			Recorded events, in the order they finished.
+			*/
+			TEvents events;
+
+			/**
+			Sequential index of the owner thread, used as its id in the trace.
+			*/
+			unsigned int threadIndex;
+
+			/**
+			How many events were dropped because the buffer was full.
+			*/
+			unsigned int droppedEvents;
+		};
+
+#ifdef TRACE_FRAMES
+		/**
+		Records spans of the most relevant parts of a frame, and writes them in the trace
+		event format understood by Chrome (chrome://tracing) and Perfetto, so frames can be
+		inspected on a timeline.
+		Implemented using a one-step initialization singleton. Every thread records into its
+		own buffer, which is registered into the tracer the first time the thread records
+		something (the only moment a lock is taken).
+
+		Tracing is only compiled in when TRACE_FRAMES is defined. Otherwise, neither the tracer
+		nor its dependencies are, the macros at the end of this file expand to nothing and the
+		architecture doesn't pay anything for it.
+		*/
+		class CTracer {
+		private:
+			/**
+			Alias for the list of buffers of every thread.
+			*/
+			typedef std::vector<CTraceBuffer *> TBuffers;
+
+			/**
+			The current and unique instance of the singleton.
+			*/
+			static CTracer *_instance;
+
+			/**
+			Generation the next tracer to be created will have.
+			*/
+			static unsigned int _nextGeneration;
+
+			/**
+			Identifies this tracer among every one which has been created, so threads can tell
+			whether their buffer was registered into it or into one which was released (a new
+			tracer might be created at the same address).
+			*/
+			unsigned int _generation;
+
+			/**
+			Buffers of every thread which has recorded something.
+			*/
+			TBuffers _buffers;
+
+			/**
+			Protects the list of buffers while a new thread registers its own.
+			*/
+			std::mutex _buffersMutex;
+
+			/**
+			Amount of events every new buffer can hold.
+			*/
+			unsigned int _capacity;
+
+			/**
+			Time at which the tracer was created, in seconds. Every span is relative to it.
+			*/
+			double _origin;
+
+			/**
+			Basic constructor, private as a part of the singleton pattern.
+			*/
+			CTracer();
+
+			/**
+			Basic destructor.
+			We can only destruct it from inside, so it's private.
+			*/
+			~CTracer();
+
+			/**
+			In order to prevent accidental (or intentional) copying of the singleton instance,
+			we declare the copy constructor as private so a compile-time error is shown.
+			*/
+			CTracer(const CTracer &factory);
+
+			/**
+			In order to prevent accidental (or intentional) copying of the singleton instance,
+			we declare the assignment operator as private so a compile-time error is shown.
+			*/
+			CTracer &operator=(const CTracer &factory);
+
+			/**
+			Gets the buffer of the calling thread, creating and registering it if needed.
+			*/
+			CTraceBuffer &getThreadBuffer();
+
+		public:
+			/**
+			When the singleton won't be used anymore, we can call this method to destroy the
+			current instance. This is the only way of destroying it and not calling it would
+			leak it.
+			*/
+			static void release();
+
+			/**
+			Gets the instance of this tracer.
+			It's a singleton, and by returning instead of a pointer we are subtly declaring
+			three characteristics:
+			    - It won't be NULL: if it was a pointer, and even if we did our work
+				  initializing it, it could be NULL conceptually.
+				- It can't be changed: a pointer could be pointed somewhere else.
+				- It can't be deleted from outside code: pointers could.
+			It must be created before any other thread starts recording.
+			*/
+			static CTracer &getInstance();
+
+			/**
+			Sets how many events every thread can record. Only buffers created afterwards
+			are affected, so it should be set before anything is recorded.
+			*/
+			void setCapacity(unsigned int capacity);
+
+			/**
+			Records a span into the buffer of the calling thread.
+			*/
+			void record(const char *name, double start, double duration, const TEntityID &entity);
+
+			/**
+			Gets how many events were dropped, by every thread, because their buffer was full.
+			*/
+			unsigned int getDroppedEventCount() const;
+
+			/**
+			Writes every recorded span as a trace event JSON document.
+			No thread should be recording while it's written.
+			*/
+			void write(std::ostream &os) const;
+
+			/**
+			Writes every recorded span into a file. Returns false if it couldn't be opened.
+			*/
+			bool write(const std::string &fileName) const;
+		};
+
+		/**
+		Measures the time elapsed between its construction and destruction, and records it
+		as a span.
+		*/
+		class CTraceScope {
+		private:
+			/**
+			What is being measured.
+			*/
+			const char *_name;
+
+			/**
+			Entity the span refers to, if any.
+			*/
+			TEntityID _entity;
+
+			/**
+			Time at which the span started, in seconds.
+			*/
+			double _start;
+
+		public:
+			/**
+			Default constructor, starts measuring right away.
+			*/
+			CTraceScope(const char *name, const TEntityID &entity = CEntityID::UNASSIGNED) :
+				_name(name), _entity(entity), _start(CTimer::getSeconds()) {
+
+			}
+
+			/**
+			Default destructor, records the span.
+			*/
+			~CTraceScope() {
+				CTracer::getInstance().record(_name, _start, CTimer::getSeconds() - _start, _entity);
+			}
+		};
+#endif
+
+	}
+
+	/**
+	These next macros are the only way the rest of the architecture should talk to the
+	tracer, so it disappears completely unless TRACE_FRAMES is defined.
+	The name of every span must be a string literal.
+	*/
+#define TRACE_CONCATENATE_IMPLEMENTATION(lhs, rhs) lhs##rhs
+#define TRACE_CONCATENATE(lhs, rhs) TRACE_CONCATENATE_IMPLEMENTATION(lhs, rhs)
+
+#ifdef TRACE_FRAMES
+#define TRACE_SCOPE(name) \
+	EvolvedPlus::Profiling::CTraceScope TRACE_CONCATENATE(traceScope, __LINE__)(name)
+#define TRACE_ENTITY_SCOPE(name, entity) \
+	EvolvedPlus::Profiling::CTraceScope TRACE_CONCATENATE(traceScope, __LINE__)(name, entity)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_ENTITY_SCOPE(name, entity)
+#endif
+
+}
+
+#endif
\ No newline at end of file